@@ -0,0 +1,597 @@
+#include <getopt.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "select.h"
+#include "dbconnector.h"
+#include "subscriberstatetable.h"
+#include "fpmsyncd/fpmroutewriter.h"
+#include "fpmsyncd/rtnlroute.h"
+
+using namespace std;
+using namespace swss;
+
+/*
+ * fpmbench acts as zebra towards fpmsyncd: it connects to the FPM port and
+ * streams a synthetic route set, then reports how fast the routes land in
+ * APPL_DB ROUTE_TABLE, and optionally in ASIC_DB once RouteOrch programs them.
+ * The tables are only observed through keyspace notifications, so it runs
+ * along orchagent, which consumes ROUTE_TABLE. Redis must have the keyspace
+ * notifications enabled (notify-keyspace-events), as SONiC configures it.
+ */
+
+#define DEFAULT_ROUTE_COUNT     10000
+#define DEFAULT_TIMEOUT_SECS    60
+#define DEFAULT_FLAP_CYCLES     3
+#define SEND_CHUNK_SIZE         100
+
+#define ASIC_STATE_TABLE        "ASIC_STATE"
+#define ASIC_ROUTE_ENTRY_PREFIX "SAI_OBJECT_TYPE_ROUTE_ENTRY:"
+#define ASIC_ROUTE_DEST_FIELD   "\"dest\":\""
+
+typedef chrono::steady_clock Clock;
+
+struct BenchRoute
+{
+    unsigned char family;
+    unsigned char dst_len;
+    unsigned char dst[16];
+    string prefix;                  // Prefix as fpmsyncd writes it to APPL_DB
+};
+
+struct BenchConfig
+{
+    string server;
+    int port;
+    size_t count;
+    size_t ecmp;
+    unsigned int v6_percent;
+    int ifindex;
+    unsigned int rate;              // Routes per second, 0 for no limit
+    unsigned int timeout;
+    unsigned int cycles;
+    bool watch;
+    bool watch_asic;
+};
+
+struct Landing
+{
+    string prefix;
+    bool set;
+    Clock::time_point time;
+};
+
+/* Get the route prefix of a key of the watched table, false if not a route */
+typedef bool (*RoutePrefixParser)(const string &key, string &prefix);
+
+/* APPL_DB ROUTE_TABLE is keyed by the prefix */
+static bool parseApplRouteKey(const string &key, string &prefix)
+{
+    prefix = key;
+    return true;
+}
+
+/* ASIC_DB route entries are keyed by a JSON object holding the prefix as "dest" */
+static bool parseAsicRouteKey(const string &key, string &prefix)
+{
+    if (key.compare(0, strlen(ASIC_ROUTE_ENTRY_PREFIX), ASIC_ROUTE_ENTRY_PREFIX))
+    {
+        return false;
+    }
+
+    size_t start = key.find(ASIC_ROUTE_DEST_FIELD);
+    if (start == string::npos)
+    {
+        return false;
+    }
+
+    start += strlen(ASIC_ROUTE_DEST_FIELD);
+    size_t end = key.find('"', start);
+    if (end == string::npos)
+    {
+        return false;
+    }
+
+    prefix = key.substr(start, end - start);
+    return true;
+}
+
+/*
+ * Time when the routes are written to or removed from a table. The table is
+ * observed with a SubscriberStateTable, which follows the keyspace
+ * notifications of the table and leaves the queue of its consumer untouched.
+ */
+class RouteWatcher
+{
+public:
+    RouteWatcher(const string &name, int db, const string &table, RoutePrefixParser parser) :
+        m_name(name),
+        m_db(db),
+        m_table(table),
+        m_parser(parser),
+        m_stop(false)
+    {
+    }
+
+    const string &getName() const
+    {
+        return m_name;
+    }
+
+    void start()
+    {
+        m_thread = thread(&RouteWatcher::run, this);
+    }
+
+    void stop()
+    {
+        m_stop = true;
+        m_thread.join();
+    }
+
+    /* Move the routes landed since the last call to landings */
+    void take(vector<Landing> &landings)
+    {
+        lock_guard<mutex> lock(m_mutex);
+        landings.swap(m_landed);
+        m_landed.clear();
+    }
+
+private:
+    string m_name;
+    int m_db;
+    string m_table;
+    RoutePrefixParser m_parser;
+    thread m_thread;
+    atomic<bool> m_stop;
+    mutex m_mutex;
+    vector<Landing> m_landed;
+
+    void run()
+    {
+        DBConnector db(m_db, DBConnector::DEFAULT_UNIXSOCKET, 0);
+        SubscriberStateTable table(&db, m_table);
+        Select s;
+        s.addSelectable(&table);
+
+        string prefix;
+        while (!m_stop)
+        {
+            Selectable *sel;
+            if (s.select(&sel, 100) != Select::OBJECT)
+            {
+                continue;
+            }
+
+            deque<KeyOpFieldsValuesTuple> entries;
+            table.pops(entries);
+
+            auto now = Clock::now();
+            lock_guard<mutex> lock(m_mutex);
+            for (auto &entry : entries)
+            {
+                if (m_parser(kfvKey(entry), prefix))
+                {
+                    m_landed.push_back({ prefix, kfvOp(entry) == SET_COMMAND, now });
+                }
+            }
+        }
+    }
+};
+
+static void usage()
+{
+    cout << "Usage: fpmbench [-s server] [-p port] [-n count] [-e ecmp] [-6 percent] [-i ifname]" << endl;
+    cout << "                [-m mode] [-c cycles] [-r rate] [-t timeout] [-a] [-W]" << endl;
+    cout << "       -s server: FPM server address (default 127.0.0.1)" << endl;
+    cout << "       -p port: FPM server port (default " << FPM_DEFAULT_PORT << ")" << endl;
+    cout << "       -n count: number of routes (default " << DEFAULT_ROUTE_COUNT << ")" << endl;
+    cout << "       -e ecmp: number of next hops of each route (default 1)" << endl;
+    cout << "       -6 percent: percentage of IPv6 routes (default 0)" << endl;
+    cout << "       -i ifname: interface of the next hops (default lo)" << endl;
+    cout << "       -m mode: add: add the routes (default)" << endl;
+    cout << "                withdraw: add the routes, then withdraw them" << endl;
+    cout << "                flap: add the routes, then withdraw and add them again for cycles times" << endl;
+    cout << "       -c cycles: number of flap cycles (default " << DEFAULT_FLAP_CYCLES << ")" << endl;
+    cout << "       -r rate: routes sent per second (default 0, no limit)" << endl;
+    cout << "       -t timeout: seconds to wait for the routes to land in APPL_DB (default "
+         << DEFAULT_TIMEOUT_SECS << ")" << endl;
+    cout << "       -a: also watch the routes programmed to ASIC_DB by orchagent" << endl;
+    cout << "       -W: do not watch APPL_DB, only report the send rate" << endl;
+}
+
+static vector<BenchRoute> generateRoutes(const BenchConfig &cfg)
+{
+    vector<BenchRoute> routes(cfg.count);
+    char buf[INET6_ADDRSTRLEN + 5];
+
+    for (size_t i = 0; i < cfg.count; i++)
+    {
+        BenchRoute &route = routes[i];
+        memset(route.dst, 0, sizeof(route.dst));
+
+        if (i % 100 < cfg.v6_percent)
+        {
+            /* 2001:db8:<i>::/64 */
+            route.family = AF_INET6;
+            route.dst_len = 64;
+            route.dst[0] = 0x20;
+            route.dst[1] = 0x01;
+            route.dst[2] = 0x0d;
+            route.dst[3] = 0xb8;
+            route.dst[4] = (unsigned char)(i >> 24);
+            route.dst[5] = (unsigned char)(i >> 16);
+            route.dst[6] = (unsigned char)(i >> 8);
+            route.dst[7] = (unsigned char)i;
+        }
+        else
+        {
+            /* 16.0.0.0/24 onwards */
+            route.family = AF_INET;
+            route.dst_len = 24;
+            uint32_t dst = htonl((uint32_t)(0x10000000 + (i << 8)));
+            memcpy(route.dst, &dst, sizeof(dst));
+        }
+
+        route.prefix = formatRtnlAddr(route.family, route.dst, route.dst_len, buf, sizeof(buf));
+    }
+
+    return routes;
+}
+
+static void writeRoute(FpmRouteWriter &writer, const BenchRoute &route, bool add, const BenchConfig &cfg)
+{
+    size_t addr_size = rtnlAddrSize(route.family);
+
+    writer.begin(add ? RTM_NEWROUTE : RTM_DELROUTE, route.family, RTN_UNICAST, route.dst_len);
+    writer.addAttr(RTA_DST, route.dst, addr_size);
+
+    if (!add)
+    {
+        writer.end();
+        return;
+    }
+
+    /* Next hops 10.0.0.<n> or fc00::<n> */
+    vector<unsigned char> gateways(cfg.ecmp * addr_size, 0);
+    vector<pair<const void *, int>> nexthops;
+    for (size_t j = 0; j < cfg.ecmp; j++)
+    {
+        unsigned char *gw = &gateways[j * addr_size];
+        if (route.family == AF_INET)
+        {
+            gw[0] = 10;
+        }
+        else
+        {
+            gw[0] = 0xfc;
+        }
+        gw[addr_size - 1] = (unsigned char)(j + 1);
+        nexthops.emplace_back(gw, cfg.ifindex);
+    }
+
+    if (nexthops.size() == 1)
+    {
+        writer.addAttr(RTA_GATEWAY, nexthops[0].first, addr_size);
+        writer.addAttr(RTA_OIF, &cfg.ifindex, sizeof(cfg.ifindex));
+    }
+    else
+    {
+        writer.addMultipath(nexthops, addr_size);
+    }
+
+    writer.end();
+}
+
+static void sendAll(int fd, const vector<char> &data)
+{
+    size_t done = 0;
+    while (done < data.size())
+    {
+        ssize_t written = write(fd, data.data() + done, data.size() - done);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw system_error(errno, system_category(), "Failed to send to FPM server");
+        }
+        done += (size_t)written;
+    }
+}
+
+static double toMsecs(Clock::duration d)
+{
+    return chrono::duration<double, milli>(d).count();
+}
+
+/* Routes of a phase not landed yet in a watched table, and latencies of those landed */
+struct PhaseWatch
+{
+    RouteWatcher *watcher;
+    unordered_map<string, Clock::time_point> pending;
+    vector<double> latencies;
+    Clock::time_point last_landing;
+};
+
+static void reportWatch(const string &name, PhaseWatch &watch, Clock::time_point start, const BenchConfig &cfg)
+{
+    const string &table = watch.watcher->getName();
+    auto &latencies = watch.latencies;
+
+    if (latencies.empty())
+    {
+        cout << name << ": no route landed in " << table << endl;
+        return;
+    }
+
+    sort(latencies.begin(), latencies.end());
+    auto percentile = [&](size_t p) { return latencies[min(latencies.size() - 1, latencies.size() * p / 100)]; };
+    double land_secs = toMsecs(watch.last_landing - start) / 1000;
+
+    cout << name << ": " << latencies.size() << " routes landed in " << table << " in " << land_secs << " s";
+    if (land_secs > 0)
+    {
+        cout << " (" << (size_t)((double)latencies.size() / land_secs) << " routes/s)";
+    }
+    cout << ", latency ms p50 " << percentile(50) << " p99 " << percentile(99)
+         << " max " << latencies.back() << endl;
+
+    if (!watch.pending.empty())
+    {
+        cout << name << ": " << watch.pending.size() << " routes did not land in " << table
+             << " in " << cfg.timeout << " s" << endl;
+    }
+}
+
+/* Stream the routes, then wait for them to land in the watched tables and report */
+static void runPhase(const string &name, int fd, const vector<BenchRoute> &routes, bool add,
+                     const BenchConfig &cfg, const vector<RouteWatcher *> &watchers)
+{
+    vector<PhaseWatch> watches(watchers.size());
+    vector<Landing> landings;
+
+    for (size_t i = 0; i < watchers.size(); i++)
+    {
+        watches[i].watcher = watchers[i];
+    }
+
+    auto collect = [&]()
+    {
+        for (auto &watch : watches)
+        {
+            watch.watcher->take(landings);
+            for (auto &landing : landings)
+            {
+                auto it = watch.pending.find(landing.prefix);
+                if (it == watch.pending.end() || landing.set != add)
+                {
+                    continue;
+                }
+
+                watch.latencies.push_back(toMsecs(landing.time - it->second));
+                watch.last_landing = max(watch.last_landing, landing.time);
+                watch.pending.erase(it);
+            }
+            landings.clear();
+        }
+    };
+
+    auto pending = [&]()
+    {
+        for (auto &watch : watches)
+        {
+            if (!watch.pending.empty())
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto start = Clock::now();
+    FpmRouteWriter writer;
+
+    for (size_t i = 0; i < routes.size(); i += SEND_CHUNK_SIZE)
+    {
+        size_t end = min(routes.size(), i + SEND_CHUNK_SIZE);
+
+        if (cfg.rate)
+        {
+            this_thread::sleep_until(start + chrono::microseconds((uint64_t)i * 1000000 / cfg.rate));
+        }
+
+        writer.stream().clear();
+        for (size_t j = i; j < end; j++)
+        {
+            writeRoute(writer, routes[j], add, cfg);
+        }
+
+        /* The send time is taken before sending, so a route cannot land first */
+        auto now = Clock::now();
+        for (auto &watch : watches)
+        {
+            for (size_t j = i; j < end; j++)
+            {
+                watch.pending[routes[j].prefix] = now;
+            }
+        }
+
+        sendAll(fd, writer.stream());
+
+        collect();
+    }
+
+    auto sent = Clock::now();
+    double send_secs = toMsecs(sent - start) / 1000;
+
+    cout << name << ": sent " << routes.size() << " routes in " << send_secs << " s";
+    if (send_secs > 0)
+    {
+        cout << " (" << (size_t)((double)routes.size() / send_secs) << " routes/s)";
+    }
+    cout << endl;
+
+    auto deadline = sent + chrono::seconds(cfg.timeout);
+    while (pending() && Clock::now() < deadline)
+    {
+        this_thread::sleep_for(chrono::milliseconds(10));
+        collect();
+    }
+
+    for (auto &watch : watches)
+    {
+        reportWatch(name, watch, start, cfg);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    BenchConfig cfg = { "127.0.0.1", FPM_DEFAULT_PORT, DEFAULT_ROUTE_COUNT, 1, 0, 0, 0,
+                        DEFAULT_TIMEOUT_SECS, DEFAULT_FLAP_CYCLES, true, false };
+    string ifname = "lo";
+    string mode = "add";
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:p:n:e:6:i:m:c:r:t:aWh")) != -1)
+    {
+        switch (opt)
+        {
+        case 's':
+            cfg.server = optarg;
+            break;
+        case 'p':
+            cfg.port = atoi(optarg);
+            break;
+        case 'n':
+            cfg.count = (size_t)atol(optarg);
+            break;
+        case 'e':
+            cfg.ecmp = max((size_t)1, (size_t)atoi(optarg));
+            break;
+        case '6':
+            cfg.v6_percent = min(100u, (unsigned int)atoi(optarg));
+            break;
+        case 'i':
+            ifname = optarg;
+            break;
+        case 'm':
+            mode = optarg;
+            break;
+        case 'c':
+            cfg.cycles = (unsigned int)atoi(optarg);
+            break;
+        case 'r':
+            cfg.rate = (unsigned int)atoi(optarg);
+            break;
+        case 't':
+            cfg.timeout = (unsigned int)atoi(optarg);
+            break;
+        case 'a':
+            cfg.watch_asic = true;
+            break;
+        case 'W':
+            cfg.watch = false;
+            break;
+        case 'h':
+            usage();
+            return 0;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (mode != "add" && mode != "withdraw" && mode != "flap")
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    cfg.ifindex = (int)if_nametoindex(ifname.c_str());
+    if (!cfg.ifindex)
+    {
+        cerr << "Unknown interface " << ifname << endl;
+        return EXIT_FAILURE;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)cfg.port);
+    if (inet_pton(AF_INET, cfg.server.c_str(), &addr.sin_addr) != 1)
+    {
+        cerr << "Invalid server address " << cfg.server << endl;
+        return EXIT_FAILURE;
+    }
+
+    int fd = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        cerr << "Failed to connect to " << cfg.server << ":" << cfg.port << ": " << strerror(errno) << endl;
+        return EXIT_FAILURE;
+    }
+
+    vector<BenchRoute> routes = generateRoutes(cfg);
+
+    RouteWatcher applWatcher("APPL_DB", APPL_DB, APP_ROUTE_TABLE_NAME, parseApplRouteKey);
+    RouteWatcher asicWatcher("ASIC_DB", ASIC_DB, ASIC_STATE_TABLE, parseAsicRouteKey);
+    vector<RouteWatcher *> watchers;
+    if (cfg.watch)
+    {
+        watchers.push_back(&applWatcher);
+        if (cfg.watch_asic)
+        {
+            watchers.push_back(&asicWatcher);
+        }
+    }
+
+    for (auto watcher : watchers)
+    {
+        watcher->start();
+    }
+
+    try
+    {
+        runPhase("add", fd, routes, true, cfg, watchers);
+
+        if (mode == "withdraw")
+        {
+            runPhase("withdraw", fd, routes, false, cfg, watchers);
+        }
+        else if (mode == "flap")
+        {
+            for (unsigned int i = 1; i <= cfg.cycles; i++)
+            {
+                runPhase("flap " + to_string(i) + " withdraw", fd, routes, false, cfg, watchers);
+                runPhase("flap " + to_string(i) + " add", fd, routes, true, cfg, watchers);
+            }
+        }
+    }
+    catch (const exception &e)
+    {
+        cerr << "Exception \"" << e.what() << "\" had been thrown" << endl;
+    }
+
+    for (auto watcher : watchers)
+    {
+        watcher->stop();
+    }
+
+    close(fd);
+    return 0;
+}
@@ -16,6 +16,14 @@
 
 namespace swss {
 
+/* Receiver of the route messages decoded in place from the FPM buffer */
+class FpmRouteHandler
+{
+public:
+    virtual ~FpmRouteHandler() { }
+    virtual void onRouteMsg(struct nlmsghdr *h) = 0;
+};
+
 class FpmLink : public Selectable {
 public:
     const int MSG_BATCH_SIZE;
@@ -25,6 +33,9 @@ public:
     /* Wait for connection (blocking) */
     void accept();
 
+    /* Route messages are passed to the handler instead of NetDispatcher */
+    void setRouteHandler(FpmRouteHandler *handler) { m_routeHandler = handler; }
+
     int getFd() override;
     void readData() override;
     /* readMe throws FpmConnectionClosedException when connection is lost */
@@ -41,6 +52,8 @@ private:
     bool m_server_up;
     int m_server_socket;
     int m_connection_socket;
+
+    FpmRouteHandler *m_routeHandler;
 };
 
 }
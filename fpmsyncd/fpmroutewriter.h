@@ -0,0 +1,105 @@
+#ifndef __FPMROUTEWRITER__
+#define __FPMROUTEWRITER__
+
+#include <arpa/inet.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include <string.h>
+#include <utility>
+#include <vector>
+
+#include "fpmsyncd/fpm/fpm.h"
+
+namespace swss {
+
+/*
+ * Append route messages to an FPM stream, as zebra sends them: a message is
+ * started by begin(), its attributes are appended, and it is completed by end().
+ */
+class FpmRouteWriter
+{
+public:
+    std::vector<char> &stream()
+    {
+        return m_stream;
+    }
+
+    void begin(int msg_type, unsigned char family, unsigned char type, unsigned char dst_len)
+    {
+        m_start = m_stream.size();
+        m_stream.resize(m_start + FPM_MSG_HDR_LEN + NLMSG_LENGTH(sizeof(struct rtmsg)));
+
+        struct nlmsghdr *h = header();
+        memset(h, 0, NLMSG_LENGTH(sizeof(struct rtmsg)));
+        h->nlmsg_len = (__u32)NLMSG_LENGTH(sizeof(struct rtmsg));
+        h->nlmsg_type = (__u16)msg_type;
+
+        struct rtmsg *rtm = (struct rtmsg *)NLMSG_DATA(h);
+        rtm->rtm_family = family;
+        rtm->rtm_type = type;
+        rtm->rtm_dst_len = dst_len;
+        rtm->rtm_table = RT_TABLE_MAIN;
+        rtm->rtm_protocol = RTPROT_ZEBRA;
+    }
+
+    void addAttr(unsigned short type, const void *data, size_t len)
+    {
+        size_t offset = m_stream.size();
+        m_stream.resize(offset + RTA_SPACE(len));
+
+        struct rtattr *rta = (struct rtattr *)&m_stream[offset];
+        rta->rta_type = type;
+        rta->rta_len = (unsigned short)RTA_LENGTH(len);
+        memcpy(RTA_DATA(rta), data, len);
+
+        header()->nlmsg_len = (__u32)(m_stream.size() - m_start - FPM_MSG_HDR_LEN);
+    }
+
+    /* Next hops as gateway address (or NULL) and interface index */
+    void addMultipath(const std::vector<std::pair<const void *, int>> &nexthops, size_t addr_size)
+    {
+        std::vector<char> data;
+        for (auto &nh : nexthops)
+        {
+            size_t offset = data.size();
+            size_t len = sizeof(struct rtnexthop) + (nh.first ? RTA_SPACE(addr_size) : 0);
+            data.resize(offset + RTNH_ALIGN(len));
+
+            struct rtnexthop *rtnh = (struct rtnexthop *)&data[offset];
+            rtnh->rtnh_len = (unsigned short)len;
+            rtnh->rtnh_ifindex = nh.second;
+
+            if (nh.first)
+            {
+                struct rtattr *rta = RTNH_DATA(rtnh);
+                rta->rta_type = RTA_GATEWAY;
+                rta->rta_len = (unsigned short)RTA_LENGTH(addr_size);
+                memcpy(RTA_DATA(rta), nh.first, addr_size);
+            }
+        }
+
+        addAttr(RTA_MULTIPATH, data.data(), data.size());
+    }
+
+    void end()
+    {
+        fpm_msg_hdr_t *hdr = (fpm_msg_hdr_t *)&m_stream[m_start];
+        hdr->version = FPM_PROTO_VERSION;
+        hdr->msg_type = FPM_MSG_TYPE_NETLINK;
+        hdr->msg_len = htons((uint16_t)(m_stream.size() - m_start));
+    }
+
+private:
+    std::vector<char> m_stream;
+    size_t m_start;
+
+    struct nlmsghdr *header()
+    {
+        return (struct nlmsghdr *)&m_stream[m_start + FPM_MSG_HDR_LEN];
+    }
+};
+
+}
+
+#endif
@@ -1,22 +1,90 @@
+#include <getopt.h>
+#include <chrono>
 #include <iostream>
 #include "logger.h"
 #include "select.h"
+#include "table.h"
 #include "netdispatcher.h"
+#include "netlink.h"
 #include "fpmsyncd/fpmlink.h"
 #include "fpmsyncd/routesync.h"
 
 using namespace std;
 using namespace swss;
 
+#define DEFAULT_WINDOW_MSECS    10
+#define DEFAULT_BATCH_SIZE      10000
+/* Route updates written at once while the FPM socket is not read */
+#define FLOW_CONTROL_FLUSH_SIZE 1000
+#define STATS_INTERVAL_SECS     10
+#define FPMSYNCD_STATS_TABLE    "FPMSYNCD_STATS"
+
+void usage()
+{
+    cout << "Usage: fpmsyncd [-w window] [-b batch_size] [-H high_kb] [-L low_kb]" << endl;
+    cout << "       -w window: keep route updates up to window ms before writing them (default 10)" << endl;
+    cout << "                  0: write the route updates of each read" << endl;
+    cout << "       -b batch_size: write the route updates when as many prefixes are pending (default 10000)" << endl;
+    cout << "       -H high_kb: stop reading FPM when route updates of high_kb KB are not written to APPL_DB" << endl;
+    cout << "                   (default 0, no flow control)" << endl;
+    cout << "       -L low_kb: resume reading FPM below low_kb KB (default high_kb / 2)" << endl;
+}
+
 int main(int argc, char **argv)
 {
     swss::Logger::linkToDbNative("fpmsyncd");
+    int opt;
+    unsigned int window_ms = DEFAULT_WINDOW_MSECS;
+    size_t batch_size = DEFAULT_BATCH_SIZE;
+    size_t high_kb = 0;
+    size_t low_kb = SIZE_MAX;
+
+    while ((opt = getopt(argc, argv, "w:b:H:L:h")) != -1 )
+    {
+        switch (opt)
+        {
+        case 'w':
+            window_ms = (unsigned int)atoi(optarg);
+            break;
+        case 'b':
+            batch_size = (size_t)atoi(optarg);
+            break;
+        case 'H':
+            high_kb = (size_t)atol(optarg);
+            break;
+        case 'L':
+            low_kb = (size_t)atol(optarg);
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
     DBConnector db(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
     RedisPipeline pipeline(&db);
     RouteSync sync(&pipeline);
+    sync.setCoalescing(window_ms, batch_size);
+    sync.setFlowControl(high_kb * 1024, (low_kb == SIZE_MAX ? high_kb / 2 : low_kb) * 1024);
+
+    DBConnector counters_db(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+    Table stats_table(&counters_db, FPMSYNCD_STATS_TABLE);
+    auto last_stats_time = chrono::steady_clock::now();
+    /* Updates written at once, so that the flow control state is checked in between */
+    size_t flush_size = high_kb ? FLOW_CONTROL_FLUSH_SIZE : SIZE_MAX;
 
     NetDispatcher::getInstance().registerMessageHandler(RTM_NEWROUTE, &sync);
     NetDispatcher::getInstance().registerMessageHandler(RTM_DELROUTE, &sync);
+    NetDispatcher::getInstance().registerMessageHandler(RTM_NEWLINK, &sync);
+    NetDispatcher::getInstance().registerMessageHandler(RTM_DELLINK, &sync);
+
+    /* Keep the link names used for the next hops from the link events */
+    NetLink netlink;
+    netlink.registerGroup(RTNLGRP_LINK);
+    netlink.dumpRequest(RTM_GETLINK);
 
     while (1)
     {
@@ -25,22 +93,60 @@ int main(int argc, char **argv)
             FpmLink fpm;
             Select s;
 
+            fpm.setRouteHandler(&sync);
+
             cout << "Waiting for connection..." << endl;
             fpm.accept();
             cout << "Connected!" << endl;
 
             s.addSelectable(&fpm);
+            s.addSelectable(&netlink);
+            bool reading = true;
             while (true)
             {
                 Selectable *temps;
                 /* Reading FPM messages forever (and calling "readData" to read them) */
-                s.select(&temps);
-                pipeline.flush();
-                SWSS_LOG_DEBUG("Pipeline flushed");
+                s.select(&temps, sync.getFlushTimeout());
+
+                /* Write the coalesced route updates once they are due */
+                if (sync.getFlushTimeout() == 0 && sync.flush(flush_size))
+                {
+                    pipeline.flush();
+                    SWSS_LOG_DEBUG("Pipeline flushed");
+                }
+
+                /* Leave the FPM messages in the socket while redis is behind */
+                if (sync.updateFlowControl() != reading)
+                {
+                    reading = !reading;
+                    if (reading)
+                    {
+                        s.addSelectable(&fpm);
+                    }
+                    else
+                    {
+                        s.removeSelectable(&fpm);
+                    }
+                }
+
+                if (chrono::steady_clock::now() - last_stats_time >= chrono::seconds(STATS_INTERVAL_SECS))
+                {
+                    vector<FieldValueTuple> fvs;
+                    sync.getStats(fvs);
+                    stats_table.set(APP_ROUTE_TABLE_NAME, fvs);
+                    last_stats_time = chrono::steady_clock::now();
+                }
             }
         }
         catch (FpmLink::FpmConnectionClosedException &e)
         {
+            /* The updates received before the connection loss are still valid */
+            if (sync.flush())
+            {
+                pipeline.flush();
+            }
+            sync.updateFlowControl();
+
             cout << "Connection lost, reconnecting..." << endl;
         }
         catch (const exception& e)
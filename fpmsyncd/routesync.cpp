@@ -14,33 +14,126 @@ using namespace std;
 using namespace swss;
 
 RouteSync::RouteSync(RedisPipeline *pipeline) :
-    m_routeTable(pipeline, APP_ROUTE_TABLE_NAME, true)
+    m_routeTable(pipeline, APP_ROUTE_TABLE_NAME, true),
+    m_window(0),
+    m_batchSize(1),
+    m_pendingBase(0),
+    m_coalesced(0),
+    m_pendingBytes(0),
+    m_maxPendingBytes(0),
+    m_highWatermark(0),
+    m_lowWatermark(0),
+    m_paused(false),
+    m_pauseCount(0),
+    m_pausedTime(0)
 {
     m_nl_sock = nl_socket_alloc();
     nl_connect(m_nl_sock, NETLINK_ROUTE);
-    rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
 }
 
 void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
 {
+    if (nlmsg_type == RTM_NEWLINK || nlmsg_type == RTM_DELLINK)
+    {
+        onLink(nlmsg_type, (struct rtnl_link *)obj);
+        return;
+    }
+
     struct rtnl_route *route_obj = (struct rtnl_route *)obj;
-    struct nl_addr *dip;
+    struct nl_addr *dip = rtnl_route_get_dst(route_obj);
+
+    m_route.family = (unsigned char)rtnl_route_get_family(route_obj);
+    m_route.type = (unsigned char)rtnl_route_get_type(route_obj);
+    m_route.dst_len = (unsigned char)nl_addr_get_prefixlen(dip);
+    m_route.dst = nl_addr_get_len(dip) ? nl_addr_get_binary_addr(dip) : NULL;
+    m_route.nexthops.clear();
+
+    for (int i = 0; i < rtnl_route_get_nnexthops(route_obj); i++)
+    {
+        struct rtnl_nexthop *nexthop = rtnl_route_nexthop_n(route_obj, i);
+        struct nl_addr *addr = rtnl_route_nh_get_gateway(nexthop);
+
+        RtnlNextHop nh = { addr ? nl_addr_get_binary_addr(addr) : NULL,
+                           (unsigned int)rtnl_route_nh_get_ifindex(nexthop) };
+        m_route.nexthops.push_back(nh);
+    }
+
+    onRoute(nlmsg_type, m_route);
+}
+
+void RouteSync::onRouteMsg(struct nlmsghdr *h)
+{
+    if (!parseRtnlRoute(h, m_route))
+    {
+        SWSS_LOG_ERROR("Malformed route message of type %d\n", h->nlmsg_type);
+        return;
+    }
+
+    onRoute(h->nlmsg_type, m_route);
+}
+
+void RouteSync::onLink(int nlmsg_type, struct rtnl_link *link)
+{
+    unsigned int ifindex = (unsigned int)rtnl_link_get_ifindex(link);
+    char *ifname = rtnl_link_get_name(link);
+
+    if (nlmsg_type == RTM_DELLINK)
+    {
+        m_ifNames.erase(ifindex);
+        return;
+    }
+
+    if (ifname)
+    {
+        m_ifNames[ifindex] = ifname;
+    }
+}
+
+void RouteSync::getIfName(unsigned int ifindex, char *ifname, size_t size)
+{
+    auto it = m_ifNames.find(ifindex);
+    if (it == m_ifNames.end())
+    {
+        /* The link message may not be received yet. Get this link alone. */
+        struct rtnl_link *link = NULL;
+        if (ifindex == 0 || rtnl_link_get_kernel(m_nl_sock, (int)ifindex, NULL, &link) < 0)
+        {
+            snprintf(ifname, size, "unknown");
+            return;
+        }
+
+        char *name = rtnl_link_get_name(link);
+        if (!name)
+        {
+            rtnl_link_put(link);
+            snprintf(ifname, size, "unknown");
+            return;
+        }
+
+        it = m_ifNames.emplace(ifindex, name).first;
+        rtnl_link_put(link);
+    }
+
+    snprintf(ifname, size, "%s", it->second.c_str());
+}
+
+void RouteSync::onRoute(int nlmsg_type, const RtnlRoute &route)
+{
     char destipprefix[MAX_ADDR_SIZE + 1] = {0};
 
-    dip = rtnl_route_get_dst(route_obj);
-    nl_addr2str(dip, destipprefix, MAX_ADDR_SIZE);
-    SWSS_LOG_DEBUG("Receive new route message dest ip prefix: %s\n", destipprefix);
     /* Supports IPv4 or IPv6 address, otherwise return immediately */
-    auto family = rtnl_route_get_family(route_obj);
-    if (family != AF_INET && family != AF_INET6)
+    if (route.family != AF_INET && route.family != AF_INET6)
     {
-        SWSS_LOG_INFO("Unknown route family support: %s (object: %s)\n", destipprefix, nl_object_get_type(obj));
+        SWSS_LOG_INFO("Unknown route family support: %d\n", route.family);
         return;
     }
 
+    formatRtnlAddr(route.family, route.dst, route.dst_len, destipprefix, sizeof(destipprefix));
+    SWSS_LOG_DEBUG("Receive new route message dest ip prefix: %s\n", destipprefix);
+
     if (nlmsg_type == RTM_DELROUTE)
     {
-        m_routeTable.del(destipprefix);
+        delRoute(destipprefix);
         return;
     }
     else if (nlmsg_type != RTM_NEWROUTE)
@@ -49,14 +142,14 @@ void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
         return;
     }
 
-    switch (rtnl_route_get_type(route_obj))
+    switch (route.type)
     {
         case RTN_BLACKHOLE:
             {
                 vector<FieldValueTuple> fvVector;
                 FieldValueTuple fv("blackhole", "true");
                 fvVector.push_back(fv);
-                m_routeTable.set(destipprefix, fvVector);
+                setRoute(destipprefix, fvVector);
                 return;
             }
         case RTN_UNICAST:
@@ -76,39 +169,29 @@ void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
     string nexthops;
     string ifnames;
 
-    struct nl_list_head *nhs = rtnl_route_get_nexthops(route_obj);
-    if (!nhs)
+    if (route.nexthops.empty())
     {
         SWSS_LOG_INFO("Nexthop list is empty for %s\n", destipprefix);
         return;
     }
 
+    unsigned char addr_len = (unsigned char)(8 * rtnlAddrSize(route.family));
     char ifname[IFNAMSIZ] = {0};
-    for (int i = 0; i < rtnl_route_get_nnexthops(route_obj); i++)
+    for (size_t i = 0; i < route.nexthops.size(); i++)
     {
-        struct rtnl_nexthop *nexthop = rtnl_route_nexthop_n(route_obj, i);
-        struct nl_addr *addr = rtnl_route_nh_get_gateway(nexthop);
-        unsigned int ifindex = rtnl_route_nh_get_ifindex(nexthop);
+        const RtnlNextHop &nexthop = route.nexthops[i];
 
-        if (addr != NULL)
+        if (nexthop.gateway != NULL)
         {
             char gwipprefix[MAX_ADDR_SIZE + 1] = {0};
-            nl_addr2str(addr, gwipprefix, MAX_ADDR_SIZE);
+            formatRtnlAddr(route.family, nexthop.gateway, addr_len, gwipprefix, sizeof(gwipprefix));
             nexthops += gwipprefix;
         }
 
-        rtnl_link_i2name(m_link_cache, ifindex, ifname, IFNAMSIZ);
-        /* Cannot get ifname. Possibly interfaces get re-created. */
-        if (!strlen(ifname))
-        {
-            rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
-            rtnl_link_i2name(m_link_cache, ifindex, ifname, IFNAMSIZ);
-            if (!strlen(ifname))
-                strcpy(ifname, "unknown");
-        }
+        getIfName(nexthop.ifindex, ifname, IFNAMSIZ);
         ifnames += ifname;
 
-        if (i + 1 < rtnl_route_get_nnexthops(route_obj))
+        if (i + 1 < route.nexthops.size())
         {
             nexthops += string(",");
             ifnames += string(",");
@@ -120,6 +203,183 @@ void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
     FieldValueTuple idx("ifname", ifnames);
     fvVector.push_back(nh);
     fvVector.push_back(idx);
-    m_routeTable.set(destipprefix, fvVector);
+    setRoute(destipprefix, fvVector);
     SWSS_LOG_DEBUG("RoutTable set: %s %s %s\n", destipprefix, nexthops.c_str(), ifnames.c_str());
 }
+
+void RouteSync::setCoalescing(unsigned int window_ms, size_t batch_size)
+{
+    m_window = chrono::milliseconds(window_ms);
+    m_batchSize = max(batch_size, (size_t)1);
+}
+
+void RouteSync::setFlowControl(size_t high_bytes, size_t low_bytes)
+{
+    m_highWatermark = high_bytes;
+    m_lowWatermark = min(low_bytes, high_bytes);
+}
+
+bool RouteSync::updateFlowControl()
+{
+    m_maxPendingBytes = max(m_maxPendingBytes, m_pendingBytes);
+
+    if (!m_highWatermark)
+    {
+        return true;
+    }
+
+    auto now = chrono::steady_clock::now();
+    if (!m_paused && m_pendingBytes >= m_highWatermark)
+    {
+        SWSS_LOG_NOTICE("Stop reading FPM, %zu bytes of route updates pending", m_pendingBytes);
+        m_paused = true;
+        m_pausedSince = now;
+        m_pauseCount++;
+    }
+    else if (m_paused && m_pendingBytes <= m_lowWatermark)
+    {
+        auto paused = chrono::duration_cast<chrono::milliseconds>(now - m_pausedSince);
+        SWSS_LOG_NOTICE("Resume reading FPM after %lld ms, %zu bytes of route updates pending",
+                        (long long)paused.count(), m_pendingBytes);
+        m_paused = false;
+        m_pausedTime += paused;
+    }
+
+    return !m_paused;
+}
+
+size_t RouteSync::valuesBytes(const vector<FieldValueTuple> &values)
+{
+    size_t bytes = 0;
+    for (auto &fv : values)
+    {
+        bytes += sizeof(fv) + fvField(fv).size() + fvValue(fv).size();
+    }
+    return bytes;
+}
+
+RouteUpdate &RouteSync::getPending(const char *prefix)
+{
+    if (m_pending.empty())
+    {
+        m_pendingSince = chrono::steady_clock::now();
+    }
+
+    auto it = m_pendingIndex.find(prefix);
+    if (it != m_pendingIndex.end())
+    {
+        m_coalesced++;
+        return m_pending[it->second - m_pendingBase];
+    }
+
+    m_pendingIndex.emplace(prefix, m_pendingBase + m_pending.size());
+    m_pending.push_back(RouteUpdate{ prefix, false, false, {} });
+    m_pendingBytes += sizeof(RouteUpdate) + m_pending.back().prefix.size();
+    return m_pending.back();
+}
+
+/*
+ * A set replaces a pending set, so only the latest values of the prefix are
+ * written. A pending delete is kept and written before the set, so that the
+ * fields of the previous route do not remain in APPL_DB.
+ */
+void RouteSync::setRoute(const char *prefix, vector<FieldValueTuple> &values)
+{
+    RouteUpdate &update = getPending(prefix);
+    m_pendingBytes += valuesBytes(values) - valuesBytes(update.values);
+    update.set = true;
+    update.values.swap(values);
+}
+
+/*
+ * A delete cancels the pending set of the prefix. The delete itself is still
+ * written, as the prefix may have been in APPL_DB before the set.
+ */
+void RouteSync::delRoute(const char *prefix)
+{
+    RouteUpdate &update = getPending(prefix);
+    m_pendingBytes -= valuesBytes(update.values);
+    update.del = true;
+    update.set = false;
+    update.values.clear();
+}
+
+int RouteSync::getFlushTimeout() const
+{
+    if (m_pending.empty())
+    {
+        return -1;
+    }
+
+    /* Drain the pending updates while the FPM socket is not read */
+    if (m_paused || m_pending.size() >= m_batchSize)
+    {
+        return 0;
+    }
+
+    auto elapsed = chrono::steady_clock::now() - m_pendingSince;
+    if (elapsed >= m_window)
+    {
+        return 0;
+    }
+
+    return (int)chrono::duration_cast<chrono::milliseconds>(m_window - elapsed).count();
+}
+
+/*
+ * The updates are written in arrival order. A prefix written is removed from
+ * the index and its update popped, so that a later update of the prefix is
+ * written after it and the memory of the written updates is released.
+ */
+bool RouteSync::flush(size_t max_updates)
+{
+    if (m_pending.empty())
+    {
+        return false;
+    }
+
+    size_t count = min(max_updates, m_pending.size());
+    for (size_t i = 0; i < count; i++)
+    {
+        RouteUpdate &update = m_pending.front();
+        if (update.del)
+        {
+            m_routeTable.del(update.prefix);
+        }
+        if (update.set)
+        {
+            m_routeTable.set(update.prefix, update.values);
+        }
+
+        m_pendingBytes -= sizeof(RouteUpdate) + update.prefix.size() + valuesBytes(update.values);
+        m_pendingIndex.erase(update.prefix);
+        m_pending.pop_front();
+        m_pendingBase++;
+    }
+
+    SWSS_LOG_DEBUG("Wrote %zu route updates, %zu updates coalesced", count, m_coalesced);
+
+    if (m_pending.empty())
+    {
+        m_coalesced = 0;
+        m_pendingBytes = 0;
+    }
+
+    return true;
+}
+
+void RouteSync::getStats(vector<FieldValueTuple> &fvs) const
+{
+    auto paused = m_pausedTime;
+    if (m_paused)
+    {
+        paused += chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - m_pausedSince);
+    }
+
+    fvs.emplace_back("pending_updates", to_string(m_pending.size()));
+    fvs.emplace_back("pending_bytes", to_string(m_pendingBytes));
+    fvs.emplace_back("max_pending_bytes", to_string(m_maxPendingBytes));
+    fvs.emplace_back("flow_control", !m_highWatermark ? "off" : m_paused ? "paused" : "reading");
+    fvs.emplace_back("pause_count", to_string(m_pauseCount));
+    fvs.emplace_back("paused_ms", to_string(paused.count()));
+}
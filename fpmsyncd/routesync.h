@@ -4,22 +4,107 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "netmsg.h"
+#include "fpmsyncd/fpmlink.h"
+#include "fpmsyncd/rtnlroute.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
 
 namespace swss {
 
-class RouteSync : public NetMsg
+/* Latest state of a prefix not yet written to APPL_DB */
+struct RouteUpdate
+{
+    std::string prefix;
+    bool del;                               // Delete the route before setting it
+    bool set;                               // Set the route to the values
+    std::vector<FieldValueTuple> values;
+};
+
+class RouteSync : public NetMsg, public FpmRouteHandler
 {
 public:
     enum { MAX_ADDR_SIZE = 64 };
 
     RouteSync(RedisPipeline *pipeline);
 
+    /* Route messages from libnl, and link messages keeping the link names */
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
+    virtual void onRouteMsg(struct nlmsghdr *h);
+
+    /*
+     * Keep the latest state of each prefix for up to window_ms, or until
+     * batch_size prefixes are pending, before writing them to APPL_DB. The
+     * thresholds are checked by getFlushTimeout().
+     */
+    void setCoalescing(unsigned int window_ms, size_t batch_size);
+
+    /*
+     * Stop reading the FPM socket once the updates not yet written to APPL_DB
+     * take high_bytes, and resume below low_bytes, so that zebra is pushed
+     * back by TCP while redis is behind. 0 disables the flow control.
+     */
+    void setFlowControl(size_t high_bytes, size_t low_bytes);
+
+    /* Update the flow control state, return whether the FPM socket is to be read */
+    bool updateFlowControl();
+
+    /* Time in ms until the pending updates are due, -1 if there are none */
+    int getFlushTimeout() const;
+
+    /* Write up to max_updates pending updates, return false if there were none */
+    bool flush(size_t max_updates = SIZE_MAX);
+
+    /* Queue depth and flow control counters */
+    void getStats(std::vector<FieldValueTuple> &fvs) const;
 
 private:
     ProducerStateTable m_routeTable;
-    struct nl_cache *m_link_cache;
     struct nl_sock *m_nl_sock;
+
+    /* Link names by ifindex, kept up to date by the RTNLGRP_LINK messages */
+    std::unordered_map<unsigned int, std::string> m_ifNames;
+
+    /* Route being processed, reused to keep the next hop storage */
+    RtnlRoute m_route;
+
+    std::chrono::milliseconds m_window;
+    size_t m_batchSize;
+    /*
+     * Pending updates in arrival order, and their index by prefix. The index
+     * holds the sequence numbers of the updates, the front update being
+     * m_pendingBase, so that written updates are popped from the front.
+     */
+    std::deque<RouteUpdate> m_pending;
+    std::unordered_map<std::string, size_t> m_pendingIndex;
+    size_t m_pendingBase;
+    std::chrono::steady_clock::time_point m_pendingSince;
+    /* Number of updates merged into the pending updates */
+    size_t m_coalesced;
+
+    /* Estimated memory of the pending updates, and its highest value */
+    size_t m_pendingBytes;
+    size_t m_maxPendingBytes;
+
+    size_t m_highWatermark;
+    size_t m_lowWatermark;
+    bool m_paused;
+    std::chrono::steady_clock::time_point m_pausedSince;
+    size_t m_pauseCount;
+    std::chrono::milliseconds m_pausedTime;
+
+    void setRoute(const char *prefix, std::vector<FieldValueTuple> &values);
+    void delRoute(const char *prefix);
+    RouteUpdate &getPending(const char *prefix);
+    static size_t valuesBytes(const std::vector<FieldValueTuple> &values);
+
+    void onRoute(int nlmsg_type, const RtnlRoute &route);
+    void onLink(int nlmsg_type, struct rtnl_link *link);
+    void getIfName(unsigned int ifindex, char *ifname, size_t size);
 };
 
 }
@@ -0,0 +1,165 @@
+#ifndef __RTNLROUTE__
+#define __RTNLROUTE__
+
+#include <arpa/inet.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+namespace swss {
+
+struct RtnlNextHop
+{
+    const void *gateway;        // Gateway address, NULL if the next hop has none
+    unsigned int ifindex;       // Output interface index, 0 if the next hop has none
+};
+
+/*
+ * Route of an RTM_NEWROUTE/RTM_DELROUTE message. The addresses point into the
+ * message, so the route is valid as long as the message buffer is.
+ */
+struct RtnlRoute
+{
+    unsigned char family;
+    unsigned char type;
+    unsigned char dst_len;          // Destination prefix length
+    const void *dst;                // Destination address, NULL if the message has none
+    std::vector<RtnlNextHop> nexthops;
+};
+
+inline size_t rtnlAddrSize(unsigned char family)
+{
+    return family == AF_INET ? sizeof(struct in_addr) : sizeof(struct in6_addr);
+}
+
+/*
+ * Decode the route message in place, without allocating a libnl route object.
+ * The next hops are taken from RTA_MULTIPATH, or from RTA_GATEWAY and RTA_OIF
+ * when it is absent. Returns false when the message is malformed.
+ */
+inline bool parseRtnlRoute(const struct nlmsghdr *h, RtnlRoute &route)
+{
+    if (h->nlmsg_len < NLMSG_LENGTH(sizeof(struct rtmsg)))
+    {
+        return false;
+    }
+
+    const struct rtmsg *rtm = (const struct rtmsg *)NLMSG_DATA(h);
+    route.family = rtm->rtm_family;
+    route.type = rtm->rtm_type;
+    route.dst_len = rtm->rtm_dst_len;
+    route.dst = NULL;
+    route.nexthops.clear();
+
+    if (route.family != AF_INET && route.family != AF_INET6)
+    {
+        /* The addresses of other families are not decoded */
+        return true;
+    }
+
+    size_t addr_size = rtnlAddrSize(route.family);
+    const struct rtattr *gateway = NULL;
+    const struct rtattr *oif = NULL;
+    const struct rtattr *multipath = NULL;
+
+    int len = (int)(h->nlmsg_len - NLMSG_LENGTH(sizeof(struct rtmsg)));
+    for (const struct rtattr *rta = RTM_RTA(rtm); RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+    {
+        switch (rta->rta_type)
+        {
+            case RTA_DST:
+                if (RTA_PAYLOAD(rta) != addr_size)
+                    return false;
+                route.dst = RTA_DATA(rta);
+                break;
+            case RTA_GATEWAY:
+                if (RTA_PAYLOAD(rta) != addr_size)
+                    return false;
+                gateway = rta;
+                break;
+            case RTA_OIF:
+                if (RTA_PAYLOAD(rta) < sizeof(unsigned int))
+                    return false;
+                oif = rta;
+                break;
+            case RTA_MULTIPATH:
+                multipath = rta;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (multipath)
+    {
+        const struct rtnexthop *rtnh = (const struct rtnexthop *)RTA_DATA(multipath);
+        int nh_len = (int)RTA_PAYLOAD(multipath);
+
+        while (RTNH_OK(rtnh, nh_len))
+        {
+            RtnlNextHop nexthop = { NULL, (unsigned int)rtnh->rtnh_ifindex };
+
+            int attr_len = rtnh->rtnh_len - (int)sizeof(struct rtnexthop);
+            for (const struct rtattr *rta = RTNH_DATA(rtnh); RTA_OK(rta, attr_len); rta = RTA_NEXT(rta, attr_len))
+            {
+                if (rta->rta_type == RTA_GATEWAY)
+                {
+                    if (RTA_PAYLOAD(rta) != addr_size)
+                        return false;
+                    nexthop.gateway = RTA_DATA(rta);
+                }
+            }
+
+            route.nexthops.push_back(nexthop);
+
+            nh_len -= RTNH_ALIGN(rtnh->rtnh_len);
+            rtnh = RTNH_NEXT(rtnh);
+        }
+    }
+    else if (gateway || oif)
+    {
+        RtnlNextHop nexthop = { NULL, 0 };
+        if (gateway)
+            nexthop.gateway = RTA_DATA(gateway);
+        if (oif)
+            nexthop.ifindex = *(const unsigned int *)RTA_DATA(oif);
+        route.nexthops.push_back(nexthop);
+    }
+
+    return true;
+}
+
+/*
+ * Format the address as libnl nl_addr2str() does, with the prefix length
+ * appended when it is shorter than the address.
+ */
+inline const char *formatRtnlAddr(unsigned char family, const void *addr, unsigned char prefixlen,
+                                  char *buf, size_t size)
+{
+    unsigned int max_len = (unsigned int)(8 * rtnlAddrSize(family));
+
+    if (!addr)
+    {
+        snprintf(buf, size, "none");
+        max_len = 0;
+    }
+    else if (!inet_ntop(family, addr, buf, (socklen_t)size))
+    {
+        buf[0] = '\0';
+    }
+
+    if (prefixlen != max_len)
+    {
+        size_t len = strlen(buf);
+        snprintf(buf + len, size - len, "/%u", prefixlen);
+    }
+
+    return buf;
+}
+
+}
+
+#endif
@@ -719,16 +719,16 @@ sai_object_id_t AclRuleL3::getRedirectObjectId(const string& redirect_value)
     string target = redirect_value.substr(colon_pos + 1);
 
     // Try to parse physical port and LAG first
-    Port port;
-    if (gPortsOrch->getPort(target, port))
+    const Port *port = gPortsOrch->findPort(target);
+    if (port)
     {
-        if (port.m_type == Port::PHY)
+        if (port->m_type == Port::PHY)
         {
-            return port.m_port_id;
+            return port->m_port_id;
         }
-        else if (port.m_type == Port::LAG)
+        else if (port->m_type == Port::LAG)
         {
-            return port.m_lag_id;
+            return port->m_lag_id;
         }
         else
         {
@@ -2159,8 +2159,7 @@ bool AclOrch::processPorts(AclTable &aclTable, string portsList, std::function<v
     for (const auto& alias : strList)
     {
         sai_object_id_t port_id;
-        Port port;
-        if (!gPortsOrch->getPort(alias, port))
+        if (!gPortsOrch->findPort(alias))
         {
             SWSS_LOG_INFO("Port %s not configured yet, add it to ACL table %s pending list", alias.c_str(), aclTable.description.c_str());
             aclTable.pendingPortSet.emplace(alias);
@@ -2188,8 +2187,7 @@ bool AclOrch::processPendingPort(AclTable &aclTable, string portAlias, std::func
 
     sai_object_id_t port_id;
 
-    Port port;
-    if (!gPortsOrch->getPort(portAlias, port))
+    if (!gPortsOrch->findPort(portAlias))
     {
         SWSS_LOG_INFO("Port %s not configured yet, add it to ACL table %s pending list", portAlias.c_str(), aclTable.description.c_str());
         aclTable.pendingPortSet.insert(portAlias);
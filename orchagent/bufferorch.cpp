@@ -115,13 +115,64 @@ bool BufferOrch::isPortReady(const std::string& port_name) const
     return result;
 }
 
-task_process_status BufferOrch::processBufferPool(Consumer &consumer)
+/* Re-queue the port tasks waiting for the buffer configuration of the ports */
+void BufferOrch::resolvePortReady(const vector<string> &port_names)
+{
+    for (const auto &port_name : port_names)
+    {
+        if (isPortReady(port_name))
+        {
+            RetryCache::resolveAll(Constraint(RETRY_CST_PORT_READY, port_name));
+        }
+    }
+}
+
+/*
+ * Find a buffer profile referenced by the task, in its profile or profile
+ * list field, that is not created yet
+ */
+bool BufferOrch::getMissingProfile(const KeyOpFieldsValuesTuple &tuple, string &profile_name)
+{
+    const object_map *profiles = m_buffer_type_maps[CFG_BUFFER_PROFILE_TABLE_NAME];
+
+    for (const auto &fv : kfvFieldsValues(tuple))
+    {
+        if (fvField(fv) != buffer_profile_field_name && fvField(fv) != buffer_profile_list_field_name)
+        {
+            continue;
+        }
+
+        for (const auto &ref : tokenize(fvValue(fv), list_item_delimiter))
+        {
+            if (ref.size() < 3 || ref.front() != ref_start || ref.back() != ref_end)
+            {
+                continue;
+            }
+
+            string ref_content = ref.substr(1, ref.size() - 2);
+            vector<string> tokens = tokenize(ref_content, delimiter);
+            if (tokens.size() != 2)
+            {
+                tokens = tokenize(ref_content, config_db_key_delimiter);
+            }
+
+            if (tokens.size() == 2 && tokens[0] == CFG_BUFFER_PROFILE_TABLE_NAME
+                && profiles->find(tokens[1]) == profiles->end())
+            {
+                profile_name = tokens[1];
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+task_process_status BufferOrch::processBufferPool(Consumer &consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
     sai_status_t sai_status;
     sai_object_id_t sai_object = SAI_NULL_OBJECT_ID;
-    auto it = consumer.m_toSync.begin();
-    KeyOpFieldsValuesTuple tuple = it->second;
     string map_type_name = consumer.getTableName();
     string object_name = kfvKey(tuple);
     string op = kfvOp(tuple);
@@ -241,13 +292,11 @@ task_process_status BufferOrch::processBufferPool(Consumer &consumer)
     return task_process_status::task_success;
 }
 
-task_process_status BufferOrch::processBufferProfile(Consumer &consumer)
+task_process_status BufferOrch::processBufferProfile(Consumer &consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
     sai_status_t sai_status;
     sai_object_id_t sai_object = SAI_NULL_OBJECT_ID;
-    auto it = consumer.m_toSync.begin();
-    KeyOpFieldsValuesTuple tuple = it->second;
     string map_type_name = consumer.getTableName();
     string object_name = kfvKey(tuple);
     string op = kfvOp(tuple);
@@ -357,6 +406,9 @@ task_process_status BufferOrch::processBufferProfile(Consumer &consumer)
             }
             (*(m_buffer_type_maps[map_type_name]))[object_name] = sai_object;
             SWSS_LOG_NOTICE("Created buffer profile %s with type %s", object_name.c_str(), map_type_name.c_str());
+
+            /* Re-queue the queue, PG and port tasks waiting for the profile */
+            RetryCache::resolveAll(Constraint(RETRY_CST_BUFFER_PROFILE, object_name));
         }
     }
     else if (op == DEL_COMMAND)
@@ -382,11 +434,9 @@ task_process_status BufferOrch::processBufferProfile(Consumer &consumer)
 /*
 Input sample "BUFFER_QUEUE_TABLE:Ethernet4,Ethernet45:10-15"
 */
-task_process_status BufferOrch::processQueue(Consumer &consumer)
+task_process_status BufferOrch::processQueue(Consumer &consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
-    auto it = consumer.m_toSync.begin();
-    KeyOpFieldsValuesTuple tuple = it->second;
     sai_object_id_t sai_buffer_profile;
     const string key = kfvKey(tuple);
     string op = kfvOp(tuple);
@@ -419,11 +469,11 @@ task_process_status BufferOrch::processQueue(Consumer &consumer)
     sai_attribute_t attr;
     attr.id = SAI_QUEUE_ATTR_BUFFER_PROFILE_ID;
     attr.value.oid = sai_buffer_profile;
-    for (string port_name : port_names)
+    for (const string &port_name : port_names)
     {
-        Port port;
         SWSS_LOG_DEBUG("processing port:%s", port_name.c_str());
-        if (!gPortsOrch->getPort(port_name, port))
+        const Port *port = gPortsOrch->findPort(port_name);
+        if (!port)
         {
             SWSS_LOG_ERROR("Port with alias:%s not found", port_name.c_str());
             return task_process_status::task_invalid_entry;
@@ -432,12 +482,12 @@ task_process_status BufferOrch::processQueue(Consumer &consumer)
         {
             sai_object_id_t queue_id;
             SWSS_LOG_DEBUG("processing queue:%zd", ind);
-            if (port.m_queue_ids.size() <= ind)
+            if (port->m_queue_ids.size() <= ind)
             {
                 SWSS_LOG_ERROR("Invalid queue index specified:%zd", ind);
                 return task_process_status::task_invalid_entry;
             }
-            queue_id = port.m_queue_ids[ind];
+            queue_id = port->m_queue_ids[ind];
             SWSS_LOG_DEBUG("Applying buffer profile:0x%lx to queue index:%zd, queue sai_id:0x%lx", sai_buffer_profile, ind, queue_id);
             sai_status_t sai_status = sai_queue_api->set_queue_attribute(queue_id, &attr);
             if (sai_status != SAI_STATUS_SUCCESS)
@@ -451,6 +501,7 @@ task_process_status BufferOrch::processQueue(Consumer &consumer)
     if (m_ready_list.find(key) != m_ready_list.end())
     {
         m_ready_list[key] = true;
+        resolvePortReady(port_names);
     }
     else
     {
@@ -463,11 +514,9 @@ task_process_status BufferOrch::processQueue(Consumer &consumer)
 /*
 Input sample "BUFFER_PG_TABLE|Ethernet4,Ethernet45|10-15"
 */
-task_process_status BufferOrch::processPriorityGroup(Consumer &consumer)
+task_process_status BufferOrch::processPriorityGroup(Consumer &consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
-    auto it = consumer.m_toSync.begin();
-    KeyOpFieldsValuesTuple tuple = it->second;
     sai_object_id_t sai_buffer_profile;
     const string key = kfvKey(tuple);
     string op = kfvOp(tuple);
@@ -506,11 +555,11 @@ task_process_status BufferOrch::processPriorityGroup(Consumer &consumer)
     sai_attribute_t attr;
     attr.id = SAI_INGRESS_PRIORITY_GROUP_ATTR_BUFFER_PROFILE;
     attr.value.oid = sai_buffer_profile;
-    for (string port_name : port_names)
+    for (const string &port_name : port_names)
     {
-        Port port;
         SWSS_LOG_DEBUG("processing port:%s", port_name.c_str());
-        if (!gPortsOrch->getPort(port_name, port))
+        const Port *port = gPortsOrch->findPort(port_name);
+        if (!port)
         {
             SWSS_LOG_ERROR("Port with alias:%s not found", port_name.c_str());
             return task_process_status::task_invalid_entry;
@@ -519,12 +568,12 @@ task_process_status BufferOrch::processPriorityGroup(Consumer &consumer)
         {
             sai_object_id_t pg_id;
             SWSS_LOG_DEBUG("processing pg:%zd", ind);
-            if (port.m_priority_group_ids.size() <= ind)
+            if (port->m_priority_group_ids.size() <= ind)
             {
                 SWSS_LOG_ERROR("Invalid pg index specified:%zd", ind);
                 return task_process_status::task_invalid_entry;
             }
-            pg_id = port.m_priority_group_ids[ind];
+            pg_id = port->m_priority_group_ids[ind];
             SWSS_LOG_DEBUG("Applying buffer profile:0x%lx to port:%s pg index:%zd, pg sai_id:0x%lx", sai_buffer_profile, port_name.c_str(), ind, pg_id);
             sai_status_t sai_status = sai_buffer_api->set_ingress_priority_group_attribute(pg_id, &attr);
             if (sai_status != SAI_STATUS_SUCCESS)
@@ -538,6 +587,7 @@ task_process_status BufferOrch::processPriorityGroup(Consumer &consumer)
     if (m_ready_list.find(key) != m_ready_list.end())
     {
         m_ready_list[key] = true;
+        resolvePortReady(port_names);
     }
     else
     {
@@ -550,12 +600,9 @@ task_process_status BufferOrch::processPriorityGroup(Consumer &consumer)
 /*
 Input sample:"[BUFFER_PROFILE_TABLE:i_port.profile0],[BUFFER_PROFILE_TABLE:i_port.profile1]"
 */
-task_process_status BufferOrch::processIngressBufferProfileList(Consumer &consumer)
+task_process_status BufferOrch::processIngressBufferProfileList(Consumer &consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
-    auto it = consumer.m_toSync.begin();
-    KeyOpFieldsValuesTuple tuple = it->second;
-    Port port;
     string key = kfvKey(tuple);
     string op = kfvOp(tuple);
 
@@ -582,14 +629,15 @@ task_process_status BufferOrch::processIngressBufferProfileList(Consumer &consum
     attr.id = SAI_PORT_ATTR_QOS_INGRESS_BUFFER_PROFILE_LIST;
     attr.value.objlist.count = (uint32_t)profile_list.size();
     attr.value.objlist.list = profile_list.data();
-    for (string port_name : port_names)
+    for (const string &port_name : port_names)
     {
-        if (!gPortsOrch->getPort(port_name, port))
+        const Port *port = gPortsOrch->findPort(port_name);
+        if (!port)
         {
             SWSS_LOG_ERROR("Port with alias:%s not found", port_name.c_str());
             return task_process_status::task_invalid_entry;
         }
-        sai_status_t sai_status = sai_port_api->set_port_attribute(port.m_port_id, &attr);
+        sai_status_t sai_status = sai_port_api->set_port_attribute(port->m_port_id, &attr);
         if (sai_status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to set ingress buffer profile list on port, status:%d, key:%s", sai_status, port_name.c_str());
@@ -602,12 +650,9 @@ task_process_status BufferOrch::processIngressBufferProfileList(Consumer &consum
 /*
 Input sample:"[BUFFER_PROFILE_TABLE:e_port.profile0],[BUFFER_PROFILE_TABLE:e_port.profile1]"
 */
-task_process_status BufferOrch::processEgressBufferProfileList(Consumer &consumer)
+task_process_status BufferOrch::processEgressBufferProfileList(Consumer &consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
-    auto it = consumer.m_toSync.begin();
-    KeyOpFieldsValuesTuple tuple = it->second;
-    Port port;
     string key = kfvKey(tuple);
     string op = kfvOp(tuple);
     SWSS_LOG_DEBUG("processing:%s", key.c_str());
@@ -628,14 +673,15 @@ task_process_status BufferOrch::processEgressBufferProfileList(Consumer &consume
     attr.id = SAI_PORT_ATTR_QOS_EGRESS_BUFFER_PROFILE_LIST;
     attr.value.objlist.count = (uint32_t)profile_list.size();
     attr.value.objlist.list = profile_list.data();
-    for (string port_name : port_names)
+    for (const string &port_name : port_names)
     {
-        if (!gPortsOrch->getPort(port_name, port))
+        const Port *port = gPortsOrch->findPort(port_name);
+        if (!port)
         {
             SWSS_LOG_ERROR("Port with alias:%s not found", port_name.c_str());
             return task_process_status::task_invalid_entry;
         }
-        sai_status_t sai_status = sai_port_api->set_port_attribute(port.m_port_id, &attr);
+        sai_status_t sai_status = sai_port_api->set_port_attribute(port->m_port_id, &attr);
         if (sai_status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to set egress buffer profile list on port, status:%d, key:%s", sai_status, port_name.c_str());
@@ -645,6 +691,11 @@ task_process_status BufferOrch::processEgressBufferProfileList(Consumer &consume
     return task_process_status::task_success;
 }
 
+/*
+ * Process all the pending tasks in one pass. A task waiting for a buffer
+ * profile is parked until the profile is created, other tasks to retry stay
+ * for the next pass, without holding back the tasks after them.
+ */
 void BufferOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
@@ -666,7 +717,7 @@ void BufferOrch::doTask(Consumer &consumer)
             continue;
         }
 
-        auto task_status = (this->*(m_bufferHandlerMap[map_type_name]))(consumer);
+        auto task_status = (this->*(m_bufferHandlerMap[map_type_name]))(consumer, it->second);
         switch(task_status)
         {
             case task_process_status::task_success :
@@ -679,11 +730,20 @@ void BufferOrch::doTask(Consumer &consumer)
             case task_process_status::task_failed:
                 SWSS_LOG_ERROR("Failed to process buffer task, drop it");
                 it = consumer.m_toSync.erase(it);
-                return;
+                break;
             case task_process_status::task_need_retry:
+            {
+                string profile_name;
+                if (getMissingProfile(it->second, profile_name))
+                {
+                    SWSS_LOG_INFO("Buffer task %s waits for buffer profile %s", it->first.c_str(), profile_name.c_str());
+                    it = consumer.addToRetry(it, Constraint(RETRY_CST_BUFFER_PROFILE, profile_name));
+                    break;
+                }
                 SWSS_LOG_INFO("Failed to process buffer task, retry it");
                 it++;
                 break;
+            }
             default:
                 SWSS_LOG_ERROR("Invalid task status %d", task_status);
                 it = consumer.m_toSync.erase(it);
@@ -31,7 +31,7 @@ public:
     bool isPortReady(const std::string& port_name) const;
     static type_map m_buffer_type_maps;
 private:
-    typedef task_process_status (BufferOrch::*buffer_table_handler)(Consumer& consumer);
+    typedef task_process_status (BufferOrch::*buffer_table_handler)(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
     typedef map<string, buffer_table_handler> buffer_table_handler_map;
     typedef pair<string, buffer_table_handler> buffer_handler_pair;
 
@@ -39,12 +39,14 @@ private:
     void initTableHandlers();
     void initBufferReadyLists(DBConnector *db);
     void initBufferReadyList(Table& table);
-    task_process_status processBufferPool(Consumer &consumer);
-    task_process_status processBufferProfile(Consumer &consumer);
-    task_process_status processQueue(Consumer &consumer);
-    task_process_status processPriorityGroup(Consumer &consumer);
-    task_process_status processIngressBufferProfileList(Consumer &consumer);
-    task_process_status processEgressBufferProfileList(Consumer &consumer);
+    void resolvePortReady(const vector<string> &port_names);
+    bool getMissingProfile(const KeyOpFieldsValuesTuple &tuple, string &profile_name);
+    task_process_status processBufferPool(Consumer &consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status processBufferProfile(Consumer &consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status processQueue(Consumer &consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status processPriorityGroup(Consumer &consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status processIngressBufferProfileList(Consumer &consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status processEgressBufferProfileList(Consumer &consumer, KeyOpFieldsValuesTuple &tuple);
 
     buffer_table_handler_map m_bufferHandlerMap;
     std::unordered_map<std::string, bool> m_ready_list;
@@ -0,0 +1,561 @@
+#ifndef SWSS_BULKER_H
+#define SWSS_BULKER_H
+
+#include <vector>
+#include <algorithm>
+
+extern "C" {
+#include "sai.h"
+#include "saistatus.h"
+}
+
+#include "logger.h"
+
+/*
+ * Bulker collects SAI create/remove/set operations during one doTask pass and
+ * submits them through the SAI bulk APIs on flush(). The caller provides the
+ * address of a sai_status_t for each queued operation; the per-object status
+ * is written there on flush() and has to be checked by the caller afterwards.
+ * The status storage must stay valid until flush() returns.
+ *
+ * Operations are submitted in the order of removing, creating, and setting.
+ * When max_bulk_size is 0, or the vendor SAI does not implement the bulk API,
+ * the operations fall back to the per-object SAI calls.
+ */
+
+template <typename T>
+struct SaiBulkerTraits { };
+
+template <>
+struct SaiBulkerTraits<sai_route_api_t>
+{
+    using entry_t = sai_route_entry_t;
+    using api_t = sai_route_api_t;
+    using create_entry_fn = sai_create_route_entry_fn;
+    using remove_entry_fn = sai_remove_route_entry_fn;
+    using set_entry_attribute_fn = sai_set_route_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_create_route_entry_fn;
+    using bulk_remove_entry_fn = sai_bulk_remove_route_entry_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_set_route_entry_attribute_fn;
+};
+
+template <>
+struct SaiBulkerTraits<sai_next_hop_group_api_t>
+{
+    using api_t = sai_next_hop_group_api_t;
+    using create_object_fn = sai_create_next_hop_group_member_fn;
+    using remove_object_fn = sai_remove_next_hop_group_member_fn;
+    using bulk_create_object_fn = sai_bulk_object_create_fn;
+    using bulk_remove_object_fn = sai_bulk_object_remove_fn;
+};
+
+template <>
+struct SaiBulkerTraits<sai_vlan_api_t>
+{
+    using api_t = sai_vlan_api_t;
+    using create_object_fn = sai_create_vlan_member_fn;
+    using remove_object_fn = sai_remove_vlan_member_fn;
+    using bulk_create_object_fn = sai_bulk_object_create_fn;
+    using bulk_remove_object_fn = sai_bulk_object_remove_fn;
+};
+
+/*
+ * The neighbor, next hop and bridge port APIs have no bulk functions in this
+ * SAI version. Their bulkers are given no bulk function and always use the
+ * per-object calls on flush(), so that the callers batch them like the other
+ * objects.
+ */
+template <>
+struct SaiBulkerTraits<sai_neighbor_api_t>
+{
+    using entry_t = sai_neighbor_entry_t;
+    using api_t = sai_neighbor_api_t;
+    using create_entry_fn = sai_create_neighbor_entry_fn;
+    using remove_entry_fn = sai_remove_neighbor_entry_fn;
+    using set_entry_attribute_fn = sai_set_neighbor_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_status_t (*)(uint32_t, const sai_neighbor_entry_t *,
+                                                  const uint32_t *, const sai_attribute_t **,
+                                                  sai_bulk_op_error_mode_t, sai_status_t *);
+    using bulk_remove_entry_fn = sai_status_t (*)(uint32_t, const sai_neighbor_entry_t *,
+                                                  sai_bulk_op_error_mode_t, sai_status_t *);
+    using bulk_set_entry_attribute_fn = sai_status_t (*)(uint32_t, const sai_neighbor_entry_t *,
+                                                         const sai_attribute_t *,
+                                                         sai_bulk_op_error_mode_t, sai_status_t *);
+};
+
+template <>
+struct SaiBulkerTraits<sai_next_hop_api_t>
+{
+    using api_t = sai_next_hop_api_t;
+    using create_object_fn = sai_create_next_hop_fn;
+    using remove_object_fn = sai_remove_next_hop_fn;
+    using bulk_create_object_fn = sai_bulk_object_create_fn;
+    using bulk_remove_object_fn = sai_bulk_object_remove_fn;
+};
+
+template <>
+struct SaiBulkerTraits<sai_bridge_api_t>
+{
+    using api_t = sai_bridge_api_t;
+    using create_object_fn = sai_create_bridge_port_fn;
+    using remove_object_fn = sai_remove_bridge_port_fn;
+    using bulk_create_object_fn = sai_bulk_object_create_fn;
+    using bulk_remove_object_fn = sai_bulk_object_remove_fn;
+};
+
+static inline bool isBulkApiUnsupported(sai_status_t status)
+{
+    return status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED;
+}
+
+/*
+ * Status of one object of a bulk call. The statuses are initialized to
+ * SAI_STATUS_NOT_EXECUTED, an object whose status is left unfilled by a failed
+ * bulk call takes the status of the call.
+ */
+static inline sai_status_t getBulkObjectStatus(sai_status_t status, sai_status_t object_status)
+{
+    if (status != SAI_STATUS_SUCCESS && object_status == SAI_STATUS_NOT_EXECUTED)
+    {
+        return status;
+    }
+
+    return object_status;
+}
+
+template <typename T>
+class EntityBulker
+{
+public:
+    using Ts = SaiBulkerTraits<T>;
+    using Te = typename Ts::entry_t;
+
+    EntityBulker(typename Ts::api_t *api, size_t max_bulk_size);
+
+    void create_entry(
+        _Out_ sai_status_t *object_status,
+        _In_ const Te *entry,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        creating_entries.push_back(*entry);
+        creating_attrs.emplace_back(attr_list, attr_list + attr_count);
+        creating_statuses.push_back(object_status);
+        *object_status = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    void remove_entry(
+        _Out_ sai_status_t *object_status,
+        _In_ const Te *entry)
+    {
+        removing_entries.push_back(*entry);
+        removing_statuses.push_back(object_status);
+        *object_status = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    void set_entry_attribute(
+        _Out_ sai_status_t *object_status,
+        _In_ const Te *entry,
+        _In_ const sai_attribute_t *attr)
+    {
+        setting_entries.push_back(*entry);
+        setting_attrs.push_back(*attr);
+        setting_statuses.push_back(object_status);
+        *object_status = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    size_t creating_entries_count() const { return creating_entries.size(); }
+    size_t removing_entries_count() const { return removing_entries.size(); }
+    size_t setting_entries_count() const { return setting_entries.size(); }
+
+    bool empty() const
+    {
+        return creating_entries.empty() && removing_entries.empty() && setting_entries.empty();
+    }
+
+    void flush()
+    {
+        flush_removing_entries();
+        flush_creating_entries();
+        flush_setting_entries();
+        clear();
+    }
+
+    void clear()
+    {
+        creating_entries.clear();
+        creating_attrs.clear();
+        creating_statuses.clear();
+        removing_entries.clear();
+        removing_statuses.clear();
+        setting_entries.clear();
+        setting_attrs.clear();
+        setting_statuses.clear();
+    }
+
+private:
+    size_t                                  max_bulk_size;
+
+    std::vector<Te>                         creating_entries;
+    std::vector<std::vector<sai_attribute_t>> creating_attrs;
+    std::vector<sai_status_t *>             creating_statuses;
+
+    std::vector<Te>                         removing_entries;
+    std::vector<sai_status_t *>             removing_statuses;
+
+    std::vector<Te>                         setting_entries;
+    std::vector<sai_attribute_t>            setting_attrs;
+    std::vector<sai_status_t *>             setting_statuses;
+
+    typename Ts::create_entry_fn            create_entry_fn;
+    typename Ts::remove_entry_fn            remove_entry_fn;
+    typename Ts::set_entry_attribute_fn     set_entry_attribute_fn;
+    typename Ts::bulk_create_entry_fn       create_entries_fn;
+    typename Ts::bulk_remove_entry_fn       remove_entries_fn;
+    typename Ts::bulk_set_entry_attribute_fn set_entries_attribute_fn;
+
+    void flush_removing_entries()
+    {
+        size_t count = removing_entries.size();
+        size_t done = 0;
+
+        while (max_bulk_size != 0 && remove_entries_fn && done < count)
+        {
+            uint32_t n = (uint32_t)std::min(count - done, max_bulk_size);
+            std::vector<sai_status_t> statuses(n, SAI_STATUS_NOT_EXECUTED);
+
+            sai_status_t status = remove_entries_fn(n, removing_entries.data() + done,
+                                                    SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            if (isBulkApiUnsupported(status))
+            {
+                SWSS_LOG_NOTICE("Bulk remove is not supported, fall back to single object removal");
+                remove_entries_fn = NULL;
+                break;
+            }
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                *removing_statuses[done + i] = getBulkObjectStatus(status, statuses[i]);
+            }
+            done += n;
+        }
+
+        for (; done < count; done++)
+        {
+            *removing_statuses[done] = remove_entry_fn(&removing_entries[done]);
+        }
+
+        SWSS_LOG_INFO("Flushed %zu removing entries", count);
+    }
+
+    void flush_creating_entries()
+    {
+        size_t count = creating_entries.size();
+        size_t done = 0;
+
+        while (max_bulk_size != 0 && create_entries_fn && done < count)
+        {
+            uint32_t n = (uint32_t)std::min(count - done, max_bulk_size);
+            std::vector<uint32_t> attr_counts(n);
+            std::vector<const sai_attribute_t *> attr_lists(n);
+            std::vector<sai_status_t> statuses(n, SAI_STATUS_NOT_EXECUTED);
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                attr_counts[i] = (uint32_t)creating_attrs[done + i].size();
+                attr_lists[i] = creating_attrs[done + i].data();
+            }
+
+            sai_status_t status = create_entries_fn(n, creating_entries.data() + done,
+                                                    attr_counts.data(), attr_lists.data(),
+                                                    SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            if (isBulkApiUnsupported(status))
+            {
+                SWSS_LOG_NOTICE("Bulk create is not supported, fall back to single object creation");
+                create_entries_fn = NULL;
+                break;
+            }
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                *creating_statuses[done + i] = getBulkObjectStatus(status, statuses[i]);
+            }
+            done += n;
+        }
+
+        for (; done < count; done++)
+        {
+            *creating_statuses[done] = create_entry_fn(&creating_entries[done],
+                                                       (uint32_t)creating_attrs[done].size(),
+                                                       creating_attrs[done].data());
+        }
+
+        SWSS_LOG_INFO("Flushed %zu creating entries", count);
+    }
+
+    void flush_setting_entries()
+    {
+        size_t count = setting_entries.size();
+        size_t done = 0;
+
+        while (max_bulk_size != 0 && set_entries_attribute_fn && done < count)
+        {
+            uint32_t n = (uint32_t)std::min(count - done, max_bulk_size);
+            std::vector<sai_status_t> statuses(n, SAI_STATUS_NOT_EXECUTED);
+
+            sai_status_t status = set_entries_attribute_fn(n, setting_entries.data() + done,
+                                                           setting_attrs.data() + done,
+                                                           SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            if (isBulkApiUnsupported(status))
+            {
+                SWSS_LOG_NOTICE("Bulk set is not supported, fall back to single object attribute setting");
+                set_entries_attribute_fn = NULL;
+                break;
+            }
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                *setting_statuses[done + i] = getBulkObjectStatus(status, statuses[i]);
+            }
+            done += n;
+        }
+
+        for (; done < count; done++)
+        {
+            *setting_statuses[done] = set_entry_attribute_fn(&setting_entries[done], &setting_attrs[done]);
+        }
+
+        SWSS_LOG_INFO("Flushed %zu setting entries", count);
+    }
+};
+
+template <>
+inline EntityBulker<sai_route_api_t>::EntityBulker(sai_route_api_t *api, size_t max_bulk_size) :
+    max_bulk_size(max_bulk_size)
+{
+    create_entry_fn = api->create_route_entry;
+    remove_entry_fn = api->remove_route_entry;
+    set_entry_attribute_fn = api->set_route_entry_attribute;
+    create_entries_fn = api->create_route_entries;
+    remove_entries_fn = api->remove_route_entries;
+    set_entries_attribute_fn = api->set_route_entries_attribute;
+}
+
+template <>
+inline EntityBulker<sai_neighbor_api_t>::EntityBulker(sai_neighbor_api_t *api, size_t max_bulk_size) :
+    max_bulk_size(max_bulk_size)
+{
+    create_entry_fn = api->create_neighbor_entry;
+    remove_entry_fn = api->remove_neighbor_entry;
+    set_entry_attribute_fn = api->set_neighbor_entry_attribute;
+    create_entries_fn = NULL;
+    remove_entries_fn = NULL;
+    set_entries_attribute_fn = NULL;
+}
+
+/*
+ * ObjectBulker is the counterpart of EntityBulker for SAI objects identified
+ * by an object ID. The ID of a created object is written to the caller
+ * provided address on flush(), and is SAI_NULL_OBJECT_ID if the creation fails.
+ */
+template <typename T>
+class ObjectBulker
+{
+public:
+    using Ts = SaiBulkerTraits<T>;
+
+    ObjectBulker(typename Ts::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size);
+
+    void create_entry(
+        _Out_ sai_status_t *object_status,
+        _Out_ sai_object_id_t *object_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        creating_attrs.emplace_back(attr_list, attr_list + attr_count);
+        creating_ids.push_back(object_id);
+        creating_statuses.push_back(object_status);
+        *object_id = SAI_NULL_OBJECT_ID;
+        *object_status = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    void remove_entry(
+        _Out_ sai_status_t *object_status,
+        _In_ sai_object_id_t object_id)
+    {
+        removing_ids.push_back(object_id);
+        removing_statuses.push_back(object_status);
+        *object_status = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    size_t creating_entries_count() const { return creating_ids.size(); }
+    size_t removing_entries_count() const { return removing_ids.size(); }
+
+    bool empty() const
+    {
+        return creating_ids.empty() && removing_ids.empty();
+    }
+
+    void flush()
+    {
+        flush_removing_entries();
+        flush_creating_entries();
+        clear();
+    }
+
+    void clear()
+    {
+        creating_attrs.clear();
+        creating_ids.clear();
+        creating_statuses.clear();
+        removing_ids.clear();
+        removing_statuses.clear();
+    }
+
+private:
+    sai_object_id_t                         switch_id;
+    size_t                                  max_bulk_size;
+
+    std::vector<std::vector<sai_attribute_t>> creating_attrs;
+    std::vector<sai_object_id_t *>          creating_ids;
+    std::vector<sai_status_t *>             creating_statuses;
+
+    std::vector<sai_object_id_t>            removing_ids;
+    std::vector<sai_status_t *>             removing_statuses;
+
+    typename Ts::create_object_fn           create_object_fn;
+    typename Ts::remove_object_fn           remove_object_fn;
+    typename Ts::bulk_create_object_fn      create_objects_fn;
+    typename Ts::bulk_remove_object_fn      remove_objects_fn;
+
+    void flush_removing_entries()
+    {
+        size_t count = removing_ids.size();
+        size_t done = 0;
+
+        while (max_bulk_size != 0 && remove_objects_fn && done < count)
+        {
+            uint32_t n = (uint32_t)std::min(count - done, max_bulk_size);
+            std::vector<sai_status_t> statuses(n, SAI_STATUS_NOT_EXECUTED);
+
+            sai_status_t status = remove_objects_fn(n, removing_ids.data() + done,
+                                                    SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            if (isBulkApiUnsupported(status))
+            {
+                SWSS_LOG_NOTICE("Bulk remove is not supported, fall back to single object removal");
+                remove_objects_fn = NULL;
+                break;
+            }
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                *removing_statuses[done + i] = getBulkObjectStatus(status, statuses[i]);
+            }
+            done += n;
+        }
+
+        for (; done < count; done++)
+        {
+            *removing_statuses[done] = remove_object_fn(removing_ids[done]);
+        }
+
+        SWSS_LOG_INFO("Flushed %zu removing objects", count);
+    }
+
+    void flush_creating_entries()
+    {
+        size_t count = creating_ids.size();
+        size_t done = 0;
+
+        while (max_bulk_size != 0 && create_objects_fn && done < count)
+        {
+            uint32_t n = (uint32_t)std::min(count - done, max_bulk_size);
+            std::vector<uint32_t> attr_counts(n);
+            std::vector<const sai_attribute_t *> attr_lists(n);
+            std::vector<sai_object_id_t> ids(n, SAI_NULL_OBJECT_ID);
+            std::vector<sai_status_t> statuses(n, SAI_STATUS_NOT_EXECUTED);
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                attr_counts[i] = (uint32_t)creating_attrs[done + i].size();
+                attr_lists[i] = creating_attrs[done + i].data();
+            }
+
+            sai_status_t status = create_objects_fn(switch_id, n, attr_counts.data(), attr_lists.data(),
+                                                    SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                                    ids.data(), statuses.data());
+            if (isBulkApiUnsupported(status))
+            {
+                SWSS_LOG_NOTICE("Bulk create is not supported, fall back to single object creation");
+                create_objects_fn = NULL;
+                break;
+            }
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                *creating_statuses[done + i] = getBulkObjectStatus(status, statuses[i]);
+                *creating_ids[done + i] = *creating_statuses[done + i] == SAI_STATUS_SUCCESS ? ids[i] : SAI_NULL_OBJECT_ID;
+            }
+            done += n;
+        }
+
+        for (; done < count; done++)
+        {
+            *creating_statuses[done] = create_object_fn(creating_ids[done], switch_id,
+                                                        (uint32_t)creating_attrs[done].size(),
+                                                        creating_attrs[done].data());
+            if (*creating_statuses[done] != SAI_STATUS_SUCCESS)
+            {
+                *creating_ids[done] = SAI_NULL_OBJECT_ID;
+            }
+        }
+
+        SWSS_LOG_INFO("Flushed %zu creating objects", count);
+    }
+};
+
+template <>
+inline ObjectBulker<sai_next_hop_group_api_t>::ObjectBulker(sai_next_hop_group_api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_object_fn = api->create_next_hop_group_member;
+    remove_object_fn = api->remove_next_hop_group_member;
+    create_objects_fn = api->create_next_hop_group_members;
+    remove_objects_fn = api->remove_next_hop_group_members;
+}
+
+template <>
+inline ObjectBulker<sai_next_hop_api_t>::ObjectBulker(sai_next_hop_api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_object_fn = api->create_next_hop;
+    remove_object_fn = api->remove_next_hop;
+    create_objects_fn = NULL;
+    remove_objects_fn = NULL;
+}
+
+template <>
+inline ObjectBulker<sai_vlan_api_t>::ObjectBulker(sai_vlan_api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_object_fn = api->create_vlan_member;
+    remove_object_fn = api->remove_vlan_member;
+    create_objects_fn = api->create_vlan_members;
+    remove_objects_fn = api->remove_vlan_members;
+}
+
+template <>
+inline ObjectBulker<sai_bridge_api_t>::ObjectBulker(sai_bridge_api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_object_fn = api->create_bridge_port;
+    remove_object_fn = api->remove_bridge_port;
+    create_objects_fn = NULL;
+    remove_objects_fn = NULL;
+}
+
+#endif /* SWSS_BULKER_H */
@@ -219,8 +219,8 @@ void FdbOrch::doTask(Consumer& consumer)
         vector<string> keys = tokenize(kfvKey(t), ':', 1);
         string op = kfvOp(t);
 
-        Port vlan;
-        if (!m_portsOrch->getPort(keys[0], vlan))
+        const Port *vlan = m_portsOrch->findPort(keys[0]);
+        if (!vlan)
         {
             SWSS_LOG_INFO("Failed to locate %s", keys[0].c_str());
             it++;
@@ -229,7 +229,7 @@ void FdbOrch::doTask(Consumer& consumer)
 
         FdbEntry entry;
         entry.mac = MacAddress(keys[1]);
-        entry.bv_id = vlan.m_vlan_info.vlan_oid;
+        entry.bv_id = vlan->m_vlan_info.vlan_oid;
 
         if (op == SET_COMMAND)
         {
@@ -398,9 +398,9 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name, const
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
-    Port port;
     /* Retry until port is created */
-    if (!m_portsOrch->getPort(port_name, port))
+    const Port *port = m_portsOrch->findPort(port_name);
+    if (!port)
     {
         SWSS_LOG_DEBUG("Saving a fdb entry until port %s becomes active", port_name.c_str());
         saved_fdb_entries[port_name].push_back({entry, type});
@@ -409,7 +409,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name, const
     }
 
     /* Retry until port is added to the VLAN */
-    if (!port.m_bridge_port_id)
+    if (!port->m_bridge_port_id)
     {
         SWSS_LOG_DEBUG("Saving a fdb entry until port %s has got a bridge port ID", port_name.c_str());
         saved_fdb_entries[port_name].push_back({entry, type});
@@ -425,7 +425,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name, const
     attrs.push_back(attr);
 
     attr.id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
-    attr.value.oid = port.m_bridge_port_id;
+    attr.value.oid = port->m_bridge_port_id;
     attrs.push_back(attr);
 
     attr.id = SAI_FDB_ENTRY_ATTR_PACKET_ACTION;
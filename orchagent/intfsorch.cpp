@@ -283,7 +283,8 @@ bool IntfsOrch::addRouterIntfs(Port &port)
         throw runtime_error("Failed to create router interface.");
     }
 
-    gPortsOrch->setPort(port.m_alias, port);
+    sai_object_id_t rif_id = port.m_rif_id;
+    gPortsOrch->updatePort(port.m_alias, [rif_id](Port &p) { p.m_rif_id = rif_id; });
 
     SWSS_LOG_NOTICE("Create router interface for port %s mtu %u", port.m_alias.c_str(), port.m_mtu);
 
@@ -308,7 +309,7 @@ bool IntfsOrch::removeRouterIntfs(Port &port)
     }
 
     port.m_rif_id = 0;
-    gPortsOrch->setPort(port.m_alias, port);
+    gPortsOrch->updatePort(port.m_alias, [](Port &p) { p.m_rif_id = 0; });
 
     SWSS_LOG_NOTICE("Remove router interface for port %s", port.m_alias.c_str());
 
@@ -40,6 +40,11 @@ MacAddress gMacAddress;
 #define DEFAULT_BATCH_SIZE  128
 int gBatchSize = DEFAULT_BATCH_SIZE;
 
+#define DEFAULT_MAX_BULK_SIZE   1000
+size_t gMaxBulkSize = DEFAULT_MAX_BULK_SIZE;
+
+bool gNhgInPlaceUpdate = false;
+
 bool gSairedisRecord = true;
 bool gSwssRecord = true;
 bool gLogRotate = false;
@@ -48,7 +53,7 @@ string gRecordFile;
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-b batch_size] [-m MAC]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-b batch_size] [-k bulk_size] [-m MAC] [-u]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    0: do not record logs" << endl;
@@ -57,7 +62,10 @@ void usage()
     cout << "                    3: enable both above two records" << endl;
     cout << "    -d record_location: set record logs folder location (default .)" << endl;
     cout << "    -b batch_size: set consumer table pop operation batch size (default 128)" << endl;
+    cout << "    -k bulk_size: set maximum number of objects in a SAI bulk call (default 1000)" << endl;
+    cout << "                  0: do not use SAI bulk calls" << endl;
     cout << "    -m MAC: set switch MAC address" << endl;
+    cout << "    -u: update the members of a next hop group used by a single route in place" << endl;
 }
 
 void sighup_handler(int signo)
@@ -94,16 +102,22 @@ int main(int argc, char **argv)
 
     string record_location = ".";
 
-    while ((opt = getopt(argc, argv, "b:m:r:d:h")) != -1)
+    while ((opt = getopt(argc, argv, "b:k:m:r:d:hu")) != -1)
     {
         switch (opt)
         {
         case 'b':
             gBatchSize = atoi(optarg);
             break;
+        case 'k':
+            gMaxBulkSize = (size_t)atoi(optarg);
+            break;
         case 'm':
             gMacAddress = MacAddress(optarg);
             break;
+        case 'u':
+            gNhgInPlaceUpdate = true;
+            break;
         case 'r':
             if (!strcmp(optarg, "0"))
             {
@@ -12,11 +12,14 @@ extern PortsOrch *gPortsOrch;
 extern sai_object_id_t gSwitchId;
 extern CrmOrch *gCrmOrch;
 extern RouteOrch *gRouteOrch;
+extern size_t gMaxBulkSize;
 
 const int neighorch_pri = 30;
 
 NeighOrch::NeighOrch(DBConnector *db, string tableName, IntfsOrch *intfsOrch) :
-        Orch(db, tableName, neighorch_pri), m_intfsOrch(intfsOrch)
+        Orch(db, tableName, neighorch_pri), m_intfsOrch(intfsOrch),
+        m_neighborBulker(sai_neighbor_api, gMaxBulkSize),
+        m_nextHopBulker(sai_next_hop_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 }
@@ -26,11 +29,14 @@ bool NeighOrch::hasNextHop(IpAddress ipAddress)
     return m_syncdNextHops.find(ipAddress) != m_syncdNextHops.end();
 }
 
-bool NeighOrch::addNextHop(IpAddress ipAddress, string alias)
+/* Queue the creation of the next hop of a neighbor whose entry is created */
+void NeighOrch::addNextHop(NeighborBulkContext& ctx)
 {
     SWSS_LOG_ENTER();
 
-    assert(!hasNextHop(ipAddress));
+    const IpAddress &ipAddress = ctx.neighbor_entry.ip_address;
+    const string &alias = ctx.neighbor_entry.alias;
+
     sai_object_id_t rif_id = m_intfsOrch->getRouterIntfsId(alias);
 
     vector<sai_attribute_t> next_hop_attrs;
@@ -48,24 +54,30 @@ bool NeighOrch::addNextHop(IpAddress ipAddress, string alias)
     next_hop_attr.value.oid = rif_id;
     next_hop_attrs.push_back(next_hop_attr);
 
-    sai_object_id_t next_hop_id;
-    sai_status_t status = sai_next_hop_api->create_next_hop(&next_hop_id, gSwitchId, (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to create next hop %s on %s, rv:%d",
-                       ipAddress.to_string().c_str(), alias.c_str(), status);
-        return false;
-    }
+    m_nextHopBulker.create_entry(&ctx.next_hop_status, &ctx.next_hop_id,
+                                 (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
+}
+
+/* Sync the next hop created in bulk with its neighbor */
+void NeighOrch::addNextHopPost(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const IpAddress &ipAddress = ctx.neighbor_entry.ip_address;
+    const string &alias = ctx.neighbor_entry.alias;
+
+    assert(!hasNextHop(ipAddress));
 
     SWSS_LOG_NOTICE("Created next hop %s on %s",
                     ipAddress.to_string().c_str(), alias.c_str());
 
     NextHopEntry next_hop_entry;
-    next_hop_entry.next_hop_id = next_hop_id;
+    next_hop_entry.next_hop_id = ctx.next_hop_id;
     next_hop_entry.ref_count = 0;
     next_hop_entry.nh_flags = 0;
     next_hop_entry.if_alias = alias;
     m_syncdNextHops[ipAddress] = next_hop_entry;
+    m_interfaceNextHops[alias].insert(ipAddress);
 
     m_intfsOrch->increaseRouterIntfsRefCount(alias);
 
@@ -78,29 +90,41 @@ bool NeighOrch::addNextHop(IpAddress ipAddress, string alias)
         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP);
     }
 
-    return true;
+    /* Re-queue the tasks waiting for this next hop */
+    RetryCache::resolveAll(Constraint(RETRY_CST_NEXTHOP, ipAddress.to_string()));
 }
 
-bool NeighOrch::setNextHopFlag(const IpAddress &ipaddr, const uint32_t nh_flag)
+bool NeighOrch::setNextHopFlag(const set<IpAddress> &ipaddrs, const uint32_t nh_flag)
 {
     SWSS_LOG_ENTER();
 
-    auto nhop = m_syncdNextHops.find(ipaddr);
+    vector<IpAddress> changed;
     bool rc = false;
 
-    assert(nhop != m_syncdNextHops.end());
+    for (const auto &ipaddr : ipaddrs)
+    {
+        auto nhop = m_syncdNextHops.find(ipaddr);
 
-    if (nhop->second.nh_flags & nh_flag)
+        assert(nhop != m_syncdNextHops.end());
+
+        if (nhop->second.nh_flags & nh_flag)
+        {
+            continue;
+        }
+
+        nhop->second.nh_flags |= nh_flag;
+        changed.push_back(ipaddr);
+    }
+
+    if (changed.empty())
     {
         return true;
     }
 
-    nhop->second.nh_flags |= nh_flag;
-
     switch (nh_flag)
     {
         case NHFLAGS_IFDOWN:
-            rc = gRouteOrch->invalidnexthopinNextHopGroup(ipaddr);
+            rc = gRouteOrch->invalidnexthopsinNextHopGroups(changed);
             break;
         default:
             assert(0);
@@ -110,26 +134,37 @@ bool NeighOrch::setNextHopFlag(const IpAddress &ipaddr, const uint32_t nh_flag)
     return rc;
 }
 
-bool NeighOrch::clearNextHopFlag(const IpAddress &ipaddr, const uint32_t nh_flag)
+bool NeighOrch::clearNextHopFlag(const set<IpAddress> &ipaddrs, const uint32_t nh_flag)
 {
     SWSS_LOG_ENTER();
 
-    auto nhop = m_syncdNextHops.find(ipaddr);
+    vector<IpAddress> changed;
     bool rc = false;
 
-    assert(nhop != m_syncdNextHops.end());
+    for (const auto &ipaddr : ipaddrs)
+    {
+        auto nhop = m_syncdNextHops.find(ipaddr);
+
+        assert(nhop != m_syncdNextHops.end());
+
+        if (!(nhop->second.nh_flags & nh_flag))
+        {
+            continue;
+        }
 
-    if (!(nhop->second.nh_flags & nh_flag))
+        nhop->second.nh_flags &= ~nh_flag;
+        changed.push_back(ipaddr);
+    }
+
+    if (changed.empty())
     {
         return true;
     }
 
-    nhop->second.nh_flags &= ~nh_flag;
-
     switch (nh_flag)
     {
         case NHFLAGS_IFDOWN:
-            rc = gRouteOrch->validnexthopinNextHopGroup(ipaddr);
+            rc = gRouteOrch->validnexthopsinNextHopGroups(changed);
             break;
         default:
             assert(0);
@@ -158,35 +193,22 @@ bool NeighOrch::isNextHopFlagSet(const IpAddress &ipaddr, const uint32_t nh_flag
 bool NeighOrch::ifChangeInformNextHop(const string &alias, bool if_up)
 {
     SWSS_LOG_ENTER();
-    bool rc = true;
 
-    for (auto nhop = m_syncdNextHops.begin(); nhop != m_syncdNextHops.end(); ++nhop)
+    auto nhops = m_interfaceNextHops.find(alias);
+    if (nhops == m_interfaceNextHops.end())
     {
-        if (nhop->second.if_alias != alias)
-        {
-            continue;
-        }
-
-        if (if_up)
-        {
-            rc = clearNextHopFlag(nhop->first, NHFLAGS_IFDOWN);
-        }
-        else
-        {
-            rc = setNextHopFlag(nhop->first, NHFLAGS_IFDOWN);
-        }
-
-        if (rc == true)
-        {
-            continue;
-        }
-        else
-        {
-            break;
-        }
+        return true;
     }
 
-    return rc;
+    /* Update the groups of all the next hops on the interface at once */
+    if (if_up)
+    {
+        return clearNextHopFlag(nhops->second, NHFLAGS_IFDOWN);
+    }
+    else
+    {
+        return setNextHopFlag(nhops->second, NHFLAGS_IFDOWN);
+    }
 }
 
 bool NeighOrch::removeNextHop(IpAddress ipAddress, string alias)
@@ -202,6 +224,16 @@ bool NeighOrch::removeNextHop(IpAddress ipAddress, string alias)
         return false;
     }
 
+    auto nhops = m_interfaceNextHops.find(m_syncdNextHops[ipAddress].if_alias);
+    if (nhops != m_interfaceNextHops.end())
+    {
+        nhops->second.erase(ipAddress);
+        if (nhops->second.empty())
+        {
+            m_interfaceNextHops.erase(nhops);
+        }
+    }
+
     m_syncdNextHops.erase(ipAddress);
     m_intfsOrch->decreaseRouterIntfsRefCount(alias);
     return true;
@@ -260,6 +292,12 @@ void NeighOrch::doTask(Consumer &consumer)
         return;
     }
 
+    /* Neighbor operations queued to the bulkers in this pass, with the
+     * contexts used to reconcile their statuses once they are flushed */
+    std::deque<std::pair<SyncMap::iterator, NeighborBulkContext>> toAdd;
+    /* IP addresses whose next hop is created in this pass */
+    set<IpAddress> next_hops;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -313,12 +351,21 @@ void NeighOrch::doTask(Consumer &consumer)
                     mac_address = MacAddress(fvValue(*i));
             }
 
-            if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end() || m_syncdNeighbors[neighbor_entry] != mac_address)
+            auto neighbor = m_syncdNeighbors.find(neighbor_entry);
+            if (neighbor == m_syncdNeighbors.end() || neighbor->second != mac_address)
             {
-                if (addNeighbor(neighbor_entry, mac_address))
-                    it = consumer.m_toSync.erase(it);
-                else
+                bool create = neighbor == m_syncdNeighbors.end();
+
+                /* Create the next hop of an IP address once per pass */
+                if (create && !next_hops.insert(ip_address).second)
+                {
                     it++;
+                    continue;
+                }
+
+                toAdd.emplace_back(it, NeighborBulkContext(neighbor_entry, mac_address, create));
+                addNeighbor(toAdd.back().second);
+                it++;
             }
             else
                 /* Duplicate entry */
@@ -343,51 +390,126 @@ void NeighOrch::doTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    if (m_neighborBulker.empty())
+    {
+        return;
+    }
+
+    /* Create the neighbor entries, then the next hops of the created ones.
+     * Entries whose operation failed stay in m_toSync for retry. */
+    m_neighborBulker.flush();
+
+    for (auto& entry : toAdd)
+    {
+        if (entry.second.create && addNeighborEntryPost(entry.second))
+        {
+            addNextHop(entry.second);
+        }
+    }
+
+    m_nextHopBulker.flush();
+
+    for (auto& entry : toAdd)
+    {
+        if (addNeighborPost(entry.second))
+        {
+            consumer.m_toSync.erase(entry.first);
+        }
+    }
 }
 
-bool NeighOrch::addNeighbor(NeighborEntry neighborEntry, MacAddress macAddress)
+/* Queue the creation of the neighbor entry, or the update of its MAC address */
+void NeighOrch::addNeighbor(NeighborBulkContext& ctx)
 {
     SWSS_LOG_ENTER();
 
-    sai_status_t status;
-    IpAddress ip_address = neighborEntry.ip_address;
-    string alias = neighborEntry.alias;
-
-    sai_object_id_t rif_id = m_intfsOrch->getRouterIntfsId(alias);
+    sai_object_id_t rif_id = m_intfsOrch->getRouterIntfsId(ctx.neighbor_entry.alias);
 
     sai_neighbor_entry_t neighbor_entry;
     neighbor_entry.rif_id = rif_id;
     neighbor_entry.switch_id = gSwitchId;
-    copy(neighbor_entry.ip_address, ip_address);
+    copy(neighbor_entry.ip_address, ctx.neighbor_entry.ip_address);
 
     sai_attribute_t neighbor_attr;
     neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS;
-    memcpy(neighbor_attr.value.mac, macAddress.getMac(), 6);
+    memcpy(neighbor_attr.value.mac, ctx.mac.getMac(), 6);
 
-    if (m_syncdNeighbors.find(neighborEntry) == m_syncdNeighbors.end())
+    if (ctx.create)
     {
-        status = sai_neighbor_api->create_neighbor_entry(&neighbor_entry, 1, &neighbor_attr);
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to create neighbor %s on %s, rv:%d",
-                           macAddress.to_string().c_str(), alias.c_str(), status);
-            return false;
-        }
+        m_neighborBulker.create_entry(&ctx.neighbor_status, &neighbor_entry, 1, &neighbor_attr);
+    }
+    else
+    {
+        m_neighborBulker.set_entry_attribute(&ctx.neighbor_status, &neighbor_entry, &neighbor_attr);
+    }
+}
 
-        SWSS_LOG_NOTICE("Created neighbor %s on %s", macAddress.to_string().c_str(), alias.c_str());
-        m_intfsOrch->increaseRouterIntfsRefCount(alias);
+/*
+ * Sync the neighbor entry created in bulk, before its next hop is queued.
+ * Return false if the neighbor entry failed to be created.
+ */
+bool NeighOrch::addNeighborEntryPost(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
 
-        if (neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-        {
-            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
-        }
-        else
+    const IpAddress &ipAddress = ctx.neighbor_entry.ip_address;
+    const string &alias = ctx.neighbor_entry.alias;
+
+    if (ctx.neighbor_status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create neighbor %s on %s, rv:%d",
+                       ctx.mac.to_string().c_str(), alias.c_str(), ctx.neighbor_status);
+        return false;
+    }
+
+    SWSS_LOG_NOTICE("Created neighbor %s on %s", ctx.mac.to_string().c_str(), alias.c_str());
+    m_intfsOrch->increaseRouterIntfsRefCount(alias);
+
+    if (ipAddress.isV4())
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+    }
+    else
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+    }
+
+    return true;
+}
+
+/*
+ * Reconcile the bulk statuses of a neighbor queued by addNeighbor() and of its
+ * next hop. Return true if the neighbor is synced.
+ */
+bool NeighOrch::addNeighborPost(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    sai_status_t status;
+    const NeighborEntry &neighborEntry = ctx.neighbor_entry;
+    const IpAddress &ip_address = neighborEntry.ip_address;
+    const string &alias = neighborEntry.alias;
+    const MacAddress &macAddress = ctx.mac;
+
+    if (ctx.create)
+    {
+        /* The failure is logged by addNeighborEntryPost() */
+        if (ctx.neighbor_status != SAI_STATUS_SUCCESS)
         {
-            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+            return false;
         }
 
-        if (!addNextHop(ip_address, alias))
+        if (ctx.next_hop_status != SAI_STATUS_SUCCESS)
         {
+            SWSS_LOG_ERROR("Failed to create next hop %s on %s, rv:%d",
+                           ip_address.to_string().c_str(), alias.c_str(), ctx.next_hop_status);
+
+            sai_neighbor_entry_t neighbor_entry;
+            neighbor_entry.rif_id = m_intfsOrch->getRouterIntfsId(alias);
+            neighbor_entry.switch_id = gSwitchId;
+            copy(neighbor_entry.ip_address, ip_address);
+
             status = sai_neighbor_api->remove_neighbor_entry(&neighbor_entry);
             if (status != SAI_STATUS_SUCCESS)
             {
@@ -397,7 +519,7 @@ bool NeighOrch::addNeighbor(NeighborEntry neighborEntry, MacAddress macAddress)
             }
             m_intfsOrch->decreaseRouterIntfsRefCount(alias);
 
-            if (neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+            if (ip_address.isV4())
             {
                 gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
             }
@@ -408,14 +530,15 @@ bool NeighOrch::addNeighbor(NeighborEntry neighborEntry, MacAddress macAddress)
 
             return false;
         }
+
+        addNextHopPost(ctx);
     }
     else
     {
-        status = sai_neighbor_api->set_neighbor_entry_attribute(&neighbor_entry, &neighbor_attr);
-        if (status != SAI_STATUS_SUCCESS)
+        if (ctx.neighbor_status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to update neighbor %s on %s, rv:%d",
-                           macAddress.to_string().c_str(), alias.c_str(), status);
+                           macAddress.to_string().c_str(), alias.c_str(), ctx.neighbor_status);
             return false;
         }
         SWSS_LOG_NOTICE("Updated neighbor %s on %s", macAddress.to_string().c_str(), alias.c_str());
@@ -7,6 +7,9 @@
 #include "intfsorch.h"
 
 #include "ipaddress.h"
+#include "bulker.h"
+
+#include <deque>
 
 #define NHFLAGS_IFDOWN                  0x1 // nexthop's outbound i/f is down
 
@@ -43,6 +46,8 @@ struct NextHopEntry
 typedef map<NeighborEntry, MacAddress> NeighborTable;
 /* NextHopTable: next hop IP address, NextHopEntry */
 typedef map<IpAddress, NextHopEntry> NextHopTable;
+/* InterfaceNextHopTable: i/f name alias, IP addresses of the next hops on it */
+typedef map<string, set<IpAddress>> InterfaceNextHopTable;
 
 struct NeighborUpdate
 {
@@ -51,6 +56,23 @@ struct NeighborUpdate
     bool add;
 };
 
+struct NeighborBulkContext
+{
+    NeighborEntry       neighbor_entry;     // Neighbor to sync
+    MacAddress          mac;                // MAC address to sync
+    bool                create;             // Whether the neighbor is created, or its MAC updated
+    sai_status_t        neighbor_status;    // Bulk status of the neighbor entry
+    sai_status_t        next_hop_status;    // Bulk status of the next hop created with the neighbor
+    sai_object_id_t     next_hop_id;        // Next hop created with the neighbor
+
+    NeighborBulkContext(const NeighborEntry &entry, const MacAddress &mac, bool create)
+        : neighbor_entry(entry), mac(mac), create(create),
+          neighbor_status(SAI_STATUS_NOT_EXECUTED), next_hop_status(SAI_STATUS_NOT_EXECUTED),
+          next_hop_id(SAI_NULL_OBJECT_ID)
+    {
+    }
+};
+
 class NeighOrch : public Orch, public Subject
 {
 public:
@@ -74,15 +96,22 @@ private:
 
     NeighborTable m_syncdNeighbors;
     NextHopTable m_syncdNextHops;
+    InterfaceNextHopTable m_interfaceNextHops;
+
+    EntityBulker<sai_neighbor_api_t> m_neighborBulker;
+    ObjectBulker<sai_next_hop_api_t> m_nextHopBulker;
 
-    bool addNextHop(IpAddress, string);
+    void addNextHop(NeighborBulkContext&);
+    void addNextHopPost(NeighborBulkContext&);
     bool removeNextHop(IpAddress, string);
 
-    bool addNeighbor(NeighborEntry, MacAddress);
+    void addNeighbor(NeighborBulkContext&);
+    bool addNeighborEntryPost(NeighborBulkContext&);
+    bool addNeighborPost(NeighborBulkContext&);
     bool removeNeighbor(NeighborEntry);
 
-    bool setNextHopFlag(const IpAddress &, const uint32_t);
-    bool clearNextHopFlag(const IpAddress &, const uint32_t);
+    bool setNextHopFlag(const set<IpAddress> &, const uint32_t);
+    bool clearNextHopFlag(const set<IpAddress> &, const uint32_t);
 
     void doTask(Consumer &consumer);
 };
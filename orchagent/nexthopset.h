@@ -0,0 +1,167 @@
+#ifndef SWSS_NEXTHOPSET_H
+#define SWSS_NEXTHOPSET_H
+
+#include <set>
+#include <string>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+
+#include "ipaddress.h"
+#include "ipaddresses.h"
+
+/*
+ * NextHopSet is a handle to an interned set of next hop IP addresses. Routes
+ * using the same next hops share one copy of the set and of its canonical
+ * string, kept with a reference count in a hashed pool and freed with its last
+ * handle. An empty set is kept as a null handle. Handles of the same set
+ * compare equal by pointer.
+ */
+class NextHopSet
+{
+public:
+    NextHopSet() : m_entry(nullptr)
+    {
+    }
+
+    NextHopSet(const swss::IpAddresses &ips) : m_entry(intern(ips))
+    {
+    }
+
+    NextHopSet(const NextHopSet &other) : m_entry(other.m_entry)
+    {
+        if (m_entry)
+        {
+            m_entry->second.refs++;
+        }
+    }
+
+    NextHopSet& operator=(const NextHopSet &other)
+    {
+        NextHopSet copy(other);
+        std::swap(m_entry, copy.m_entry);
+        return *this;
+    }
+
+    ~NextHopSet()
+    {
+        release(m_entry);
+    }
+
+    const swss::IpAddresses& get() const
+    {
+        static const swss::IpAddresses empty;
+        return m_entry ? m_entry->first : empty;
+    }
+
+    /* Canonical string of the set, as given by IpAddresses::to_string() */
+    const std::string& to_string() const
+    {
+        static const std::string empty;
+        return m_entry ? m_entry->second.str : empty;
+    }
+
+    const swss::IpAddresses& operator*() const { return get(); }
+    const swss::IpAddresses* operator->() const { return &get(); }
+
+    bool operator==(const NextHopSet &other) const { return m_entry == other.m_entry; }
+    bool operator!=(const NextHopSet &other) const { return m_entry != other.m_entry; }
+    bool operator==(const swss::IpAddresses &ips) const { return get() == ips; }
+    bool operator!=(const swss::IpAddresses &ips) const { return !(get() == ips); }
+
+    /* Number of distinct next hop sets in use */
+    static size_t poolSize()
+    {
+        return pool().size();
+    }
+
+    /* Estimated heap memory used by the next hop sets in use */
+    static size_t memoryUsage()
+    {
+        /* Hash node: next pointer and cached hash. Set node: color and 3 pointers */
+        const size_t hash_node_overhead = 2 * sizeof(void *);
+        const size_t set_node_overhead = 4 * sizeof(void *);
+
+        size_t bytes = pool().bucket_count() * sizeof(void *);
+        for (const auto &entry : pool())
+        {
+            bytes += sizeof(entry) + hash_node_overhead;
+            bytes += entry.first.getSize() * (sizeof(swss::IpAddress) + set_node_overhead);
+            bytes += stringHeapBytes(entry.second.str);
+        }
+
+        return bytes;
+    }
+
+private:
+    struct Hash
+    {
+        size_t operator()(const swss::IpAddresses &ips) const
+        {
+            size_t hash = 0;
+            for (const auto &ip : ips.getIpAddresses())
+            {
+                swss::ip_addr_t addr = ip.getIp();
+                size_t h = ip.isV4() ? std::hash<uint32_t>()(addr.ip_addr.ipv4_addr)
+                    : std::hash<std::string>()(std::string(reinterpret_cast<const char *>(addr.ip_addr.ipv6_addr), 16));
+                hash ^= h + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            }
+            return hash;
+        }
+    };
+
+    struct Entry
+    {
+        size_t refs;        // Number of handles
+        std::string str;    // Canonical string
+    };
+
+    /* Next hop set, pool entry */
+    typedef std::unordered_map<swss::IpAddresses, Entry, Hash> Pool;
+
+    Pool::value_type *m_entry;
+
+    static Pool& pool()
+    {
+        static Pool sets;
+        return sets;
+    }
+
+    static Pool::value_type *intern(const swss::IpAddresses &ips)
+    {
+        if (ips.getSize() == 0)
+        {
+            return nullptr;
+        }
+
+        auto inserted = pool().emplace(ips, Entry{ 0, std::string() });
+        auto &entry = *inserted.first;
+        if (inserted.second)
+        {
+            entry.second.str = ips.to_string();
+        }
+        entry.second.refs++;
+        return &entry;
+    }
+
+    /* Heap memory of a string, none when it is stored inline */
+    static size_t stringHeapBytes(const std::string &str)
+    {
+        const char *object = reinterpret_cast<const char *>(&str);
+        if (str.data() >= object && str.data() < object + sizeof(str))
+        {
+            return 0;
+        }
+        return str.capacity() + 1;
+    }
+
+    static void release(Pool::value_type *entry)
+    {
+        if (entry && --entry->second.refs == 0)
+        {
+            pool().erase(pool().find(entry->first));
+        }
+    }
+};
+
+#endif /* SWSS_NEXTHOPSET_H */
@@ -1,5 +1,6 @@
 #include <fstream>
 #include <iostream>
+#include <chrono>
 #include <sys/time.h>
 #include "timestamp.h"
 #include "orch.h"
@@ -66,71 +67,132 @@ vector<Selectable *> Orch::getSelectables()
     return selectables;
 }
 
+vector<Consumer *> Orch::getConsumers()
+{
+    vector<Consumer *> consumers;
+    for(auto& it : m_consumerMap)
+    {
+        Consumer *consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer)
+        {
+            consumers.push_back(consumer);
+        }
+    }
+    return consumers;
+}
+
 void Consumer::execute()
 {
     SWSS_LOG_ENTER();
 
+    if (popTasks())
+    {
+        drain();
+    }
+}
+
+bool Consumer::popTasks()
+{
+    SWSS_LOG_ENTER();
+
     std::deque<KeyOpFieldsValuesTuple> entries;
     getConsumerTable()->pops(entries);
 
     /* Nothing popped */
     if (entries.empty())
     {
-        return;
+        return false;
     }
 
     for (auto& entry: entries)
     {
-        string key = kfvKey(entry);
-        string op  = kfvOp(entry);
-
         /* Record incoming tasks */
         if (gSwssRecord)
         {
             Orch::recordTuple(*this, entry);
         }
 
-        /* If a new task comes or if a DEL task comes, we directly put it into getConsumerTable().m_toSync map */
-        if (m_toSync.find(key) == m_toSync.end() || op == DEL_COMMAND)
-        {
-           m_toSync[key] = entry;
-        }
-        /* If an old task is still there, we combine the old task with new task */
-        else
-        {
-            KeyOpFieldsValuesTuple existing_data = m_toSync[key];
+        addToSync(std::move(entry));
+    }
 
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
+    return true;
+}
 
+void Consumer::addToSync(KeyOpFieldsValuesTuple &&entry)
+{
+    /* A task merged into a pending one keeps the arrival time of the latter */
+    if (m_arrivals.find(kfvKey(entry)) == m_arrivals.end())
+    {
+        m_arrivals.emplace(kfvKey(entry), chrono::steady_clock::now());
+    }
 
-            for (auto it : new_values)
-            {
-                string field = fvField(it);
-                string value = fvValue(it);
+    /* A parked task of the key is superseded by the new task */
+    m_toRetry.restore(kfvKey(entry), m_toSync);
 
-                auto iu = existing_values.begin();
-                while (iu != existing_values.end())
-                {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
-                        iu = existing_values.erase(iu);
-                    else
-                        iu++;
-                }
-                existing_values.push_back(FieldValueTuple(field, value));
-            }
-            m_toSync[key] = KeyOpFieldsValuesTuple(key, op, existing_values);
-        }
-    }
+    string key = kfvKey(entry);
+
+    /* A new task or a DEL task replaces the pending task of the key,
+     * otherwise the new task is combined with the pending task */
+    m_toSync.merge(std::move(entry));
 
-    drain();
+    m_orch->onTaskQueued(*this, key);
+}
+
+SyncMap::iterator Consumer::addToRetry(SyncMap::iterator it, const Constraint &cst)
+{
+    m_toRetry.insert(cst, std::move(it->second));
+    return m_toSync.erase(it);
 }
 
 void Consumer::drain()
 {
-    if (!m_toSync.empty())
-        m_orch->doTask(*this);
+    for (const auto &key : m_toRetry.restoreResolved(m_toSync))
+    {
+        m_orch->onTaskQueued(*this, key);
+    }
+
+    if (m_toSync.empty())
+        return;
+
+    auto start = chrono::steady_clock::now();
+
+    m_orch->doTask(*this);
+
+    uint64_t elapsed = (uint64_t)chrono::duration_cast<chrono::microseconds>(
+            chrono::steady_clock::now() - start).count();
+
+    m_stats.drain_count++;
+    m_stats.drain_time_us += elapsed;
+    m_stats.max_drain_time_us = max(m_stats.max_drain_time_us, elapsed);
+
+    updateLatency();
+}
+
+/* Account the time from arrival to doTask() of the tasks served in the drain */
+void Consumer::updateLatency()
+{
+    auto now = chrono::steady_clock::now();
+
+    for (auto it = m_arrivals.begin(); it != m_arrivals.end();)
+    {
+        if (m_toSync.count(it->first))
+        {
+            ++it;
+            continue;
+        }
+
+        if (!m_toRetry.contains(it->first))
+        {
+            uint64_t latency = (uint64_t)chrono::duration_cast<chrono::microseconds>(
+                    now - it->second).count();
+
+            m_stats.served_count++;
+            m_stats.latency_us += latency;
+            m_stats.max_latency_us = max(m_stats.max_latency_us, latency);
+        }
+
+        it = m_arrivals.erase(it);
+    }
 }
 
 /*
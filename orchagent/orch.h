@@ -6,6 +6,7 @@
 #include <map>
 #include <memory>
 #include <utility>
+#include <chrono>
 
 extern "C" {
 #include "sai.h"
@@ -19,6 +20,8 @@ extern "C" {
 #include "notificationconsumer.h"
 #include "selectabletimer.h"
 #include "macaddress.h"
+#include "syncmap.h"
+#include "retrycache.h"
 
 using namespace std;
 using namespace swss;
@@ -55,7 +58,6 @@ typedef pair<string, sai_object_id_t> object_map_pair;
 
 typedef map<string, object_map*> type_map;
 typedef pair<string, object_map*> type_map_pair;
-typedef map<string, KeyOpFieldsValuesTuple> SyncMap;
 
 typedef pair<string, int> table_name_with_pri_t;
 
@@ -91,6 +93,8 @@ public:
     virtual void execute() { }
     virtual void drain() { }
 
+    Orch *getOrch() const { return m_orch; }
+
 protected:
     Selectable *m_selectable;
     Orch *m_orch;
@@ -99,10 +103,21 @@ protected:
     Selectable *getSelectable() const { return m_selectable; }
 };
 
+struct ConsumerStats
+{
+    uint64_t drain_count;           // Number of doTask() calls
+    uint64_t drain_time_us;         // Total time spent in doTask()
+    uint64_t max_drain_time_us;     // Longest time spent in one doTask()
+    uint64_t served_count;          // Number of tasks served
+    uint64_t latency_us;            // Total time the served tasks were queued
+    uint64_t max_latency_us;        // Longest time one served task was queued
+};
+
 class Consumer : public Executor {
 public:
     Consumer(TableConsumable *select, Orch *orch)
         : Executor(select, orch)
+        , m_stats()
     {
     }
 
@@ -119,9 +134,39 @@ public:
     void execute();
     void drain();
 
+    /* Queue the new tasks of the table without running them, return whether there are any */
+    bool popTasks();
+
+    int getPri() const
+    {
+        return getConsumerTable()->getPri();
+    }
+
+    const ConsumerStats& getStats() const
+    {
+        return m_stats;
+    }
+
+    /* Queue a new task of the table after its parked and pending tasks */
+    void addToSync(KeyOpFieldsValuesTuple &&entry);
+
+    /* Park the task until the constraint is resolved, return the next task */
+    SyncMap::iterator addToRetry(SyncMap::iterator it, const Constraint &cst);
+
     /* Store the latest 'golden' status */
     // TODO: hide?
     SyncMap m_toSync;
+
+    /* Tasks waiting for objects owned by other orchs */
+    RetryCache m_toRetry;
+
+private:
+    ConsumerStats m_stats;
+
+    /* Arrival time of the queued tasks, a parked task is not accounted */
+    unordered_map<string, chrono::steady_clock::time_point> m_arrivals;
+
+    void updateLatency();
 };
 
 typedef map<string, std::shared_ptr<Executor>> ConsumerMap;
@@ -148,6 +193,13 @@ public:
     virtual ~Orch();
 
     vector<Selectable*> getSelectables();
+    vector<Consumer*> getConsumers();
+
+    /* Append the orch specific statistics of the table */
+    virtual void getTableStats(const string &tableName, vector<FieldValueTuple> &fvs) const { }
+
+    /* Called when a task of the key is queued, updated or restored in m_toSync */
+    virtual void onTaskQueued(Consumer &consumer, const string &key) { }
 
     /* Iterate all consumers in m_consumerMap and run doTask(Consumer) */
     void doTask();
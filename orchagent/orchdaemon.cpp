@@ -1,5 +1,6 @@
 #include <unistd.h>
 #include <unordered_map>
+#include <algorithm>
 #include "orchdaemon.h"
 #include "logger.h"
 #include <sairedis.h>
@@ -13,6 +14,12 @@ using namespace swss;
 /* select() function timeout retry time */
 #define SELECT_TIMEOUT 1000
 #define PFC_WD_POLL_MSECS 100
+/* Time budget of each orch in a pass over the ready consumers */
+#define RETRY_BUDGET_MSECS 100
+/* Interval of publishing the consumer statistics to COUNTERS_DB */
+#define STATS_INTERVAL_SECS 10
+
+#define ORCH_STATS_TABLE "ORCH_STATS"
 
 extern sai_switch_api_t*           sai_switch_api;
 extern sai_object_id_t             gSwitchId;
@@ -31,7 +38,8 @@ BufferOrch *gBufferOrch;
 OrchDaemon::OrchDaemon(DBConnector *applDb, DBConnector *configDb, DBConnector *stateDb) :
         m_applDb(applDb),
         m_configDb(configDb),
-        m_stateDb(stateDb)
+        m_stateDb(stateDb),
+        m_retrying(false)
 {
     SWSS_LOG_ENTER();
 }
@@ -66,7 +74,7 @@ bool OrchDaemon::init()
     gFdbOrch = new FdbOrch(m_applDb, APP_FDB_TABLE_NAME, gPortsOrch);
     IntfsOrch *intfs_orch = new IntfsOrch(m_applDb, APP_INTF_TABLE_NAME);
     gNeighOrch = new NeighOrch(m_applDb, APP_NEIGH_TABLE_NAME, intfs_orch);
-    gRouteOrch = new RouteOrch(m_applDb, APP_ROUTE_TABLE_NAME, gNeighOrch);
+    gRouteOrch = new RouteOrch(m_applDb, APP_ROUTE_TABLE_NAME, m_configDb, gNeighOrch);
     CoppOrch  *copp_orch  = new CoppOrch(m_applDb, APP_COPP_TABLE_NAME);
     TunnelDecapOrch *tunnel_decap_orch = new TunnelDecapOrch(m_applDb, APP_TUNNEL_DECAP_TABLE_NAME);
 
@@ -270,6 +278,179 @@ void OrchDaemon::flush()
     }
 }
 
+/*
+ * Tables whose done tasks may resolve the pending tasks of a table. The
+ * pending tasks of the tables not listed are retried after the tasks of any
+ * other table are done. Parked tasks are re-queued when their constraint is
+ * resolved, whatever the table.
+ */
+static const unordered_map<string, vector<string>> retryDependencies = {
+    { APP_ROUTE_TABLE_NAME,                         { APP_NEIGH_TABLE_NAME, APP_INTF_TABLE_NAME } },
+    { APP_NEIGH_TABLE_NAME,                         { APP_PORT_TABLE_NAME, APP_VLAN_TABLE_NAME, APP_LAG_TABLE_NAME, APP_INTF_TABLE_NAME } },
+    { CFG_BUFFER_POOL_TABLE_NAME,                   { APP_PORT_TABLE_NAME } },
+    { CFG_BUFFER_PROFILE_TABLE_NAME,                { APP_PORT_TABLE_NAME, CFG_BUFFER_POOL_TABLE_NAME } },
+    { CFG_BUFFER_QUEUE_TABLE_NAME,                  { APP_PORT_TABLE_NAME, CFG_BUFFER_PROFILE_TABLE_NAME } },
+    { CFG_BUFFER_PG_TABLE_NAME,                     { APP_PORT_TABLE_NAME, CFG_BUFFER_PROFILE_TABLE_NAME } },
+    { CFG_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME,    { APP_PORT_TABLE_NAME, CFG_BUFFER_PROFILE_TABLE_NAME } },
+    { CFG_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME,     { APP_PORT_TABLE_NAME, CFG_BUFFER_PROFILE_TABLE_NAME } },
+};
+
+void OrchDaemon::initDependencies()
+{
+    for (auto consumer : m_retryList)
+    {
+        m_retryCaches[&consumer->m_toRetry] = consumer;
+
+        auto dependencies = retryDependencies.find(consumer->getTableName());
+        if (dependencies == retryDependencies.end())
+        {
+            m_anyDependents.push_back(consumer);
+            continue;
+        }
+
+        for (const auto &table : dependencies->second)
+        {
+            m_dependents[table].push_back(consumer);
+        }
+    }
+}
+
+/* Queue the consumer to be run, if it has tasks to run and is not queued yet */
+void OrchDaemon::setReady(Consumer *consumer)
+{
+    if (consumer->m_toSync.empty() && !consumer->m_toRetry.hasResolved())
+    {
+        return;
+    }
+
+    if (m_ready.insert(consumer).second)
+    {
+        m_readyQueues[consumer->getPri()].push_back(consumer);
+    }
+}
+
+/* Tasks of the consumer are done, the pending tasks depending on them may be resolved */
+void OrchDaemon::setDependentsReady(Consumer *consumer)
+{
+    auto dependents = m_dependents.find(consumer->getTableName());
+    if (dependents != m_dependents.end())
+    {
+        for (auto dependent : dependents->second)
+        {
+            if (dependent != consumer)
+            {
+                setReady(dependent);
+            }
+        }
+    }
+
+    for (auto dependent : m_anyDependents)
+    {
+        if (dependent != consumer)
+        {
+            setReady(dependent);
+        }
+    }
+}
+
+/* Queue the consumers whose parked tasks are resolved */
+void OrchDaemon::setResolvedReady()
+{
+    for (auto cache : RetryCache::takeResolved())
+    {
+        auto it = m_retryCaches.find(cache);
+        if (it != m_retryCaches.end())
+        {
+            setReady(it->second);
+        }
+    }
+}
+
+/*
+ * Run the ready consumers, from the highest to the lowest priority, and in the
+ * order they got ready within a priority. A consumer gets ready when new tasks
+ * of its table are popped, when its parked tasks are resolved, or when tasks
+ * of a table it depends on are done. Each orch has its own time budget in a
+ * pass, the ready consumers of an orch out of its budget stay queued for the
+ * next pass, after new events are popped. A large batch of tasks of one orch
+ * thus does not delay the events of the other tables, nor the tasks of the
+ * other orchs.
+ */
+void OrchDaemon::runReady()
+{
+    auto budget = chrono::milliseconds(RETRY_BUDGET_MSECS);
+    unordered_map<Orch *, chrono::steady_clock::duration> spent;
+    vector<Consumer *> deferred;
+
+    setResolvedReady();
+
+    while (!m_readyQueues.empty())
+    {
+        auto queue = m_readyQueues.begin();
+        Consumer *consumer = queue->second.front();
+        queue->second.pop_front();
+        if (queue->second.empty())
+        {
+            m_readyQueues.erase(queue);
+        }
+
+        auto &orchSpent = spent[consumer->getOrch()];
+        if (orchSpent >= budget)
+        {
+            deferred.push_back(consumer);
+            continue;
+        }
+
+        m_ready.erase(consumer);
+
+        uint64_t served = consumer->getStats().served_count;
+        auto start = chrono::steady_clock::now();
+
+        consumer->drain();
+
+        orchSpent += chrono::steady_clock::now() - start;
+
+        if (consumer->getStats().served_count > served)
+        {
+            setDependentsReady(consumer);
+        }
+        setResolvedReady();
+    }
+
+    /* The deferred consumers are still marked ready, in their order */
+    for (auto consumer : deferred)
+    {
+        m_readyQueues[consumer->getPri()].push_back(consumer);
+    }
+
+    m_retrying = !m_readyQueues.empty();
+}
+
+/* Publish the pending and parked task counts, doTask() time and task latency of each table */
+void OrchDaemon::publishStats()
+{
+    for (auto consumer : m_retryList)
+    {
+        const ConsumerStats &stats = consumer->getStats();
+
+        vector<FieldValueTuple> fvs;
+        fvs.emplace_back("pending_tasks", to_string(consumer->m_toSync.size()));
+        fvs.emplace_back("parked_tasks", to_string(consumer->m_toRetry.size()));
+        fvs.emplace_back("drain_count", to_string(stats.drain_count));
+        fvs.emplace_back("drain_time_us", to_string(stats.drain_time_us));
+        fvs.emplace_back("max_drain_time_us", to_string(stats.max_drain_time_us));
+        fvs.emplace_back("served_tasks", to_string(stats.served_count));
+        fvs.emplace_back("task_latency_us", to_string(stats.latency_us));
+        fvs.emplace_back("max_task_latency_us", to_string(stats.max_latency_us));
+
+        consumer->getOrch()->getTableStats(consumer->getTableName(), fvs);
+
+        m_statsTable->set(consumer->getTableName(), fvs);
+    }
+
+    m_lastStatsTime = chrono::steady_clock::now();
+}
+
 void OrchDaemon::start()
 {
     SWSS_LOG_ENTER();
@@ -277,14 +458,32 @@ void OrchDaemon::start()
     for (Orch *o : m_orchList)
     {
         m_select->addSelectables(o->getSelectables());
+
+        for (Consumer *c : o->getConsumers())
+        {
+            m_retryList.push_back(c);
+        }
     }
 
+    /* Higher priority tables first, keep the orch order otherwise */
+    stable_sort(m_retryList.begin(), m_retryList.end(),
+                [](const Consumer *a, const Consumer *b) { return a->getPri() > b->getPri(); });
+
+    initDependencies();
+
+    m_countersDb.reset(new DBConnector(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0));
+    m_statsTable.reset(new Table(m_countersDb.get(), ORCH_STATS_TABLE));
+    m_lastStatsTime = chrono::steady_clock::now();
+
     while (true)
     {
         Selectable *s;
         int ret;
 
-        ret = m_select->select(&s, SELECT_TIMEOUT);
+        /* Do not block when ready consumers are left to run */
+        bool retrying = m_retrying;
+
+        ret = m_select->select(&s, retrying ? 0 : SELECT_TIMEOUT);
 
         if (ret == Select::ERROR)
         {
@@ -294,24 +493,46 @@ void OrchDaemon::start()
 
         if (ret == Select::TIMEOUT)
         {
-            /* Let sairedis to flush all SAI function call to ASIC DB.
-             * Normally the redis pipeline will flush when enough request
-             * accumulated. Still it is possible that small amount of
-             * requests live in it. When the daemon has nothing to do, it
-             * is a good chance to flush the pipeline  */
-            flush();
-            continue;
+            if (!retrying)
+            {
+                /* Let sairedis to flush all SAI function call to ASIC DB.
+                 * Normally the redis pipeline will flush when enough request
+                 * accumulated. Still it is possible that small amount of
+                 * requests live in it. When the daemon has nothing to do, it
+                 * is a good chance to flush the pipeline  */
+                flush();
+            }
+        }
+        else
+        {
+            auto *c = (Executor *)s;
+            auto *consumer = dynamic_cast<Consumer *>(c);
+
+            if (consumer)
+            {
+                /* The new tasks are run with the other ready consumers, by priority */
+                consumer->popTasks();
+                setReady(consumer);
+            }
+            else
+            {
+                c->execute();
+
+                /* A notification or timer may change the state the pending tasks of its orch wait for */
+                for (auto orchConsumer : c->getOrch()->getConsumers())
+                {
+                    setReady(orchConsumer);
+                }
+            }
         }
 
-        auto *c = (Executor *)s;
-        c->execute();
-
-        /* After each iteration, periodically check all m_toSync map to
-         * execute all the remaining tasks that need to be retried. */
-
-        /* TODO: Abstract Orch class to have a specific todo list */
-        for (Orch *o : m_orchList)
-            o->doTask();
+        /* After each event, run the new tasks and the pending tasks that may
+         * be resolved by the event or by the tasks done since. */
+        runReady();
 
+        if (chrono::steady_clock::now() - m_lastStatsTime >= chrono::seconds(STATS_INTERVAL_SECS))
+        {
+            publishStats();
+        }
     }
 }
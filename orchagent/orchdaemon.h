@@ -6,6 +6,14 @@
 #include "consumertable.h"
 #include "select.h"
 
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+
 #include "portsorch.h"
 #include "intfsorch.h"
 #include "neighorch.h"
@@ -42,7 +50,31 @@ private:
     std::vector<Orch *> m_orchList;
     Select *m_select;
 
+    /* Consumers from the highest to the lowest priority */
+    std::vector<Consumer *> m_retryList;
+    /* Priority, consumers whose tasks are to be run, in the order they got ready */
+    std::map<int, std::deque<Consumer *>, std::greater<int>> m_readyQueues;
+    std::unordered_set<Consumer *> m_ready;
+    /* Table name, consumers whose pending tasks may be resolved by its done tasks */
+    std::unordered_map<std::string, std::vector<Consumer *>> m_dependents;
+    /* Consumers of the tables with no declared dependencies */
+    std::vector<Consumer *> m_anyDependents;
+    /* Retry cache, consumer it parks the tasks of */
+    std::unordered_map<RetryCache *, Consumer *> m_retryCaches;
+    /* Whether ready consumers are left after the last pass */
+    bool m_retrying;
+
+    std::unique_ptr<DBConnector> m_countersDb;
+    std::unique_ptr<Table> m_statsTable;
+    std::chrono::steady_clock::time_point m_lastStatsTime;
+
     void flush();
+    void initDependencies();
+    void setReady(Consumer *consumer);
+    void setDependentsReady(Consumer *consumer);
+    void setResolvedReady();
+    void runReady();
+    void publishStats();
 };
 
 #endif /* SWSS_ORCHDAEMON_H */
@@ -0,0 +1,99 @@
+#ifndef SWSS_PORTINDEX_H
+#define SWSS_PORTINDEX_H
+
+#include <string>
+#include <unordered_map>
+
+#include "port.h"
+
+namespace swss {
+
+/*
+ * Aliases of the ports by SAI object id: by the object of the port (its port,
+ * LAG or VLAN object depending on its type), by its bridge port and by its
+ * host interface. The index is updated with the port list, before a port is
+ * replaced or removed and after it is stored.
+ */
+class PortIndex
+{
+public:
+    void insert(const std::string &alias, const Port &port)
+    {
+        add(m_objects, objectId(port), alias);
+        add(m_bridgePorts, port.m_bridge_port_id, alias);
+        add(m_hostIfs, port.m_hif_id, alias);
+    }
+
+    void erase(const std::string &alias, const Port &port)
+    {
+        remove(m_objects, objectId(port), alias);
+        remove(m_bridgePorts, port.m_bridge_port_id, alias);
+        remove(m_hostIfs, port.m_hif_id, alias);
+    }
+
+    /* Alias of the port, NULL if the id is not indexed */
+    const std::string *findObject(sai_object_id_t id) const
+    {
+        return find(m_objects, id);
+    }
+
+    const std::string *findBridgePort(sai_object_id_t bridge_port_id) const
+    {
+        return find(m_bridgePorts, bridge_port_id);
+    }
+
+    const std::string *findHostIf(sai_object_id_t hif_id) const
+    {
+        return find(m_hostIfs, hif_id);
+    }
+
+    static sai_object_id_t objectId(const Port &port)
+    {
+        switch (port.m_type)
+        {
+        case Port::PHY:
+            return port.m_port_id;
+        case Port::LAG:
+            return port.m_lag_id;
+        case Port::VLAN:
+            return port.m_vlan_info.vlan_oid;
+        default:
+            return SAI_NULL_OBJECT_ID;
+        }
+    }
+
+private:
+    typedef std::unordered_map<sai_object_id_t, std::string> AliasMap;
+
+    AliasMap m_objects;
+    AliasMap m_bridgePorts;
+    AliasMap m_hostIfs;
+
+    static void add(AliasMap &aliases, sai_object_id_t id, const std::string &alias)
+    {
+        if (id != SAI_NULL_OBJECT_ID)
+        {
+            aliases[id] = alias;
+        }
+    }
+
+    /* The id is left to the port it was given to since */
+    static void remove(AliasMap &aliases, sai_object_id_t id, const std::string &alias)
+    {
+        auto it = aliases.find(id);
+        if (it != aliases.end() && it->second == alias)
+        {
+            aliases.erase(it);
+        }
+    }
+
+    static const std::string *find(const AliasMap &aliases, sai_object_id_t id)
+    {
+        auto it = aliases.find(id);
+        return it == aliases.end() ? nullptr : &it->second;
+    }
+};
+
+}
+
+#endif /* SWSS_PORTINDEX_H */
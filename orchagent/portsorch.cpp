@@ -7,6 +7,7 @@
 #include <set>
 #include <algorithm>
 #include <tuple>
+#include <chrono>
 #include <sstream>
 
 #include <netinet/if_ether.h>
@@ -30,6 +31,7 @@ extern sai_hostif_api_t* sai_hostif_api;
 extern sai_acl_api_t* sai_acl_api;
 extern sai_queue_api_t *sai_queue_api;
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 extern NeighOrch *gNeighOrch;
 extern CrmOrch *gCrmOrch;
 extern BufferOrch *gBufferOrch;
@@ -116,7 +118,9 @@ static char* hostif_vlan_tag[] = {
  *    default VLAN and all ports removed from .1Q bridge.
  */
 PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames) :
-        Orch(db, tableNames)
+        Orch(db, tableNames),
+        m_bridgePortBulker(sai_bridge_api, gSwitchId, gMaxBulkSize),
+        m_vlanMemberBulker(sai_vlan_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 
@@ -134,7 +138,8 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames)
     m_queueTypeTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_TYPE_MAP));
 
     m_flex_db = shared_ptr<DBConnector>(new DBConnector(FLEX_COUNTER_DB, DBConnector::DEFAULT_UNIXSOCKET, 0));
-    m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_TABLE));
+    m_flexCounterPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_flex_db.get()));
+    m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flexCounterPipeline.get(), FLEX_COUNTER_TABLE, true));
     m_flexCounterGroupTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_GROUP_TABLE));
 
     vector<FieldValueTuple> fields;
@@ -160,7 +165,7 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames)
 
     m_cpuPort = Port("CPU", Port::CPU);
     m_cpuPort.m_port_id = attr.value.oid;
-    m_portList[m_cpuPort.m_alias] = m_cpuPort;
+    setPort(m_cpuPort.m_alias, m_cpuPort);
 
     /* Get port number */
     attr.id = SAI_SWITCH_ATTR_PORT_NUMBER;
@@ -336,102 +341,108 @@ map<string, Port>& PortsOrch::getAllPorts()
     return m_portList;
 }
 
+const Port *PortsOrch::findPort(const string &alias) const
+{
+    auto it = m_portList.find(alias);
+    return it == m_portList.end() ? nullptr : &it->second;
+}
+
+const Port *PortsOrch::findPort(sai_object_id_t id) const
+{
+    const string *alias = m_portIndex.findObject(id);
+    return alias ? &m_portList.at(*alias) : nullptr;
+}
+
+const Port *PortsOrch::findPortByBridgePortId(sai_object_id_t bridge_port_id) const
+{
+    const string *alias = m_portIndex.findBridgePort(bridge_port_id);
+    return alias ? &m_portList.at(*alias) : nullptr;
+}
+
 bool PortsOrch::getPort(string alias, Port &p)
 {
     SWSS_LOG_ENTER();
 
-    if (m_portList.find(alias) == m_portList.end())
+    const Port *port = findPort(alias);
+    if (!port)
     {
         return false;
     }
-    else
-    {
-        p = m_portList[alias];
-        return true;
-    }
+
+    p = *port;
+    return true;
 }
 
 bool PortsOrch::getPort(sai_object_id_t id, Port &port)
 {
     SWSS_LOG_ENTER();
 
-    for (const auto& portIter: m_portList)
+    const Port *p = findPort(id);
+    if (!p)
     {
-        switch (portIter.second.m_type)
-        {
-        case Port::PHY:
-            if(portIter.second.m_port_id == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        case Port::LAG:
-            if(portIter.second.m_lag_id == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        case Port::VLAN:
-            if (portIter.second.m_vlan_info.vlan_oid == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        default:
-            continue;
-        }
+        return false;
     }
 
-    return false;
+    port = *p;
+    return true;
 }
 
 bool PortsOrch::getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port)
 {
     SWSS_LOG_ENTER();
 
-    for (auto &it: m_portList)
+    const Port *p = findPortByBridgePortId(bridge_port_id);
+    if (!p)
     {
-        if (it.second.m_bridge_port_id == bridge_port_id)
-        {
-            port = it.second;
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    port = *p;
+    return true;
+}
+
+bool PortsOrch::getPortByHostIfId(sai_object_id_t hif_id, Port &port)
+{
+    SWSS_LOG_ENTER();
+
+    const string *alias = m_portIndex.findHostIf(hif_id);
+    if (!alias)
+    {
+        return false;
+    }
+
+    port = m_portList.at(*alias);
+    return true;
 }
 
 bool PortsOrch::getAclBindPortId(string alias, sai_object_id_t &port_id)
 {
     SWSS_LOG_ENTER();
 
-    Port port;
-    if (getPort(alias, port))
+    const Port *port = findPort(alias);
+    if (port)
     {
-        switch (port.m_type)
+        switch (port->m_type)
         {
         case Port::PHY:
-            if (port.m_lag_member_id != SAI_NULL_OBJECT_ID)
+            if (port->m_lag_member_id != SAI_NULL_OBJECT_ID)
             {
                 SWSS_LOG_WARN("Invalid configuration. Bind table to LAG member %s is not allowed", alias.c_str());
                 return false;
             }
             else
             {
-                port_id = port.m_port_id;
+                port_id = port->m_port_id;
             }
             break;
         case Port::LAG:
-            port_id = port.m_lag_id;
+            port_id = port->m_lag_id;
             break;
         case Port::VLAN:
-            port_id = port.m_vlan_info.vlan_oid;
+            port_id = port->m_vlan_info.vlan_oid;
             break;
         default:
-            SWSS_LOG_ERROR("Failed to process port. Incorrect port %s type %d", alias.c_str(), port.m_type);
+            SWSS_LOG_ERROR("Failed to process port. Incorrect port %s type %d", alias.c_str(), port->m_type);
             return false;
         }
 
@@ -445,7 +456,26 @@ bool PortsOrch::getAclBindPortId(string alias, sai_object_id_t &port_id)
 
 void PortsOrch::setPort(string alias, Port p)
 {
+    auto it = m_portList.find(alias);
+    if (it != m_portList.end())
+    {
+        m_portIndex.erase(alias, it->second);
+    }
+
     m_portList[alias] = p;
+    m_portIndex.insert(alias, p);
+}
+
+void PortsOrch::erasePort(const string &alias)
+{
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
+    {
+        return;
+    }
+
+    m_portIndex.erase(alias, it->second);
+    m_portList.erase(it);
 }
 
 void PortsOrch::getCpuPort(Port &port)
@@ -525,13 +555,13 @@ bool PortsOrch::bindAclTable(sai_object_id_t id, sai_object_id_t table_oid, sai_
     sai_status_t status;
     sai_object_id_t groupOid;
 
-    Port p;
-    if (!getPort(id, p))
+    const Port *p = findPort(id);
+    if (!p)
     {
         return false;
     }
 
-    auto &port = m_portList.find(p.m_alias)->second;
+    const Port &port = *p;
 
     if (acl_stage == ACL_STAGE_INGRESS && port.m_ingress_acl_table_group_id != 0)
     {
@@ -546,14 +576,8 @@ bool PortsOrch::bindAclTable(sai_object_id_t id, sai_object_id_t table_oid, sai_
         bool ingress = acl_stage == ACL_STAGE_INGRESS ? true : false;
         // If port ACL table group does not exist, create one
 
-        Port p;
-        if (!getPort(id, p))
-        {
-            return false;
-        }
-
         sai_acl_bind_point_type_t bind_type;
-        switch (p.m_type) {
+        switch (port.m_type) {
             case Port::PHY:
                 bind_type = SAI_ACL_BIND_POINT_TYPE_PORT;
                 break;
@@ -564,7 +588,7 @@ bool PortsOrch::bindAclTable(sai_object_id_t id, sai_object_id_t table_oid, sai_
                 bind_type = SAI_ACL_BIND_POINT_TYPE_VLAN;
                 break;
             default:
-                SWSS_LOG_ERROR("Failed to bind ACL table to port %s with unknown type %d", p.m_alias.c_str(), p.m_type);
+                SWSS_LOG_ERROR("Failed to bind ACL table to port %s with unknown type %d", port.m_alias.c_str(), port.m_type);
                 return false;
         }
 
@@ -593,14 +617,17 @@ bool PortsOrch::bindAclTable(sai_object_id_t id, sai_object_id_t table_oid, sai_
             return false;
         }
 
-        if (ingress)
-        {
-            port.m_ingress_acl_table_group_id = groupOid;
-        }
-        else
+        updatePort(port.m_alias, [ingress, groupOid](Port &p)
         {
-            port.m_egress_acl_table_group_id = groupOid;
-        }
+            if (ingress)
+            {
+                p.m_ingress_acl_table_group_id = groupOid;
+            }
+            else
+            {
+                p.m_egress_acl_table_group_id = groupOid;
+            }
+        });
 
         gCrmOrch->incCrmAclUsedCounter(CrmResourceType::CRM_ACL_GROUP, ingress ? SAI_ACL_STAGE_INGRESS : SAI_ACL_STAGE_EGRESS, SAI_ACL_BIND_POINT_TYPE_PORT);
 
@@ -983,50 +1010,49 @@ bool PortsOrch::setHostIntfsOperStatus(sai_object_id_t port_id, bool up)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_portList.begin(); it != m_portList.end(); it++)
+    const string *alias = m_portIndex.findObject(port_id);
+    if (!alias)
     {
-        if (it->second.m_port_id != port_id)
-        {
-            continue;
-        }
+        return false;
+    }
 
-        sai_attribute_t attr;
-        attr.id = SAI_HOSTIF_ATTR_OPER_STATUS;
-        attr.value.booldata = up;
+    const Port &port = m_portList.at(*alias);
 
-        sai_status_t status = sai_hostif_api->set_hostif_attribute(it->second.m_hif_id, &attr);
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_WARN("Failed to set operation status %s to host interface %s",
-                          up ? "UP" : "DOWN", it->second.m_alias.c_str());
-            return false;
-        }
-        SWSS_LOG_NOTICE("Set operation status %s to host interface %s",
-                        up ? "UP" : "DOWN", it->second.m_alias.c_str());
-        if (gNeighOrch->ifChangeInformNextHop(it->second.m_alias, up) == false)
-        {
-            SWSS_LOG_WARN("Inform nexthop operation failed for interface %s",
-                          it->second.m_alias.c_str());
-        }
-        return true;
+    sai_attribute_t attr;
+    attr.id = SAI_HOSTIF_ATTR_OPER_STATUS;
+    attr.value.booldata = up;
+
+    sai_status_t status = sai_hostif_api->set_hostif_attribute(port.m_hif_id, &attr);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_WARN("Failed to set operation status %s to host interface %s",
+                      up ? "UP" : "DOWN", port.m_alias.c_str());
+        return false;
     }
-    return false;
+    SWSS_LOG_NOTICE("Set operation status %s to host interface %s",
+                    up ? "UP" : "DOWN", port.m_alias.c_str());
+    if (gNeighOrch->ifChangeInformNextHop(port.m_alias, up) == false)
+    {
+        SWSS_LOG_WARN("Inform nexthop operation failed for interface %s",
+                      port.m_alias.c_str());
+    }
+    return true;
 }
 
 void PortsOrch::updateDbPortOperStatus(sai_object_id_t id, sai_port_oper_status_t status)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_portList.begin(); it != m_portList.end(); it++)
+    const string *alias = m_portIndex.findObject(id);
+    if (!alias)
     {
-        if (it->second.m_port_id == id)
-        {
-            vector<FieldValueTuple> tuples;
-            FieldValueTuple tuple("oper_status", oper_status_strings.at(status));
-            tuples.push_back(tuple);
-            m_portTable->set(it->first, tuples);
-        }
+        return;
     }
+
+    vector<FieldValueTuple> tuples;
+    FieldValueTuple tuple("oper_status", oper_status_strings.at(status));
+    tuples.push_back(tuple);
+    m_portTable->set(*alias, tuples);
 }
 
 bool PortsOrch::addPort(const set<int> &lane_set, uint32_t speed, int an, string fec_mode)
@@ -1109,71 +1135,121 @@ string PortsOrch::getQueueFlexCounterTableKey(string key)
     return string(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
 }
 
-bool PortsOrch::initPort(const string &alias, const set<int> &lane_set)
+bool PortsOrch::initPorts(const vector<pair<string, set<int>>> &port_lanes)
 {
     SWSS_LOG_ENTER();
 
-    /* Determine if the lane combination exists in switch */
-    if (m_portListLaneMap.find(lane_set) != m_portListLaneMap.end())
+    vector<Port> ports;
+    for (const auto &pl : port_lanes)
     {
-        sai_object_id_t id = m_portListLaneMap[lane_set];
+        const string &alias = pl.first;
+
+        /* Determine if the lane combination exists in switch */
+        auto lanes = m_portListLaneMap.find(pl.second);
+        if (lanes == m_portListLaneMap.end())
+        {
+            SWSS_LOG_ERROR("Failed to locate port lane combination alias:%s", alias.c_str());
+            return false;
+        }
 
         /* Determine if the port has already been initialized before */
-        if (m_portList.find(alias) != m_portList.end() && m_portList[alias].m_port_id == id)
+        const Port *port = findPort(alias);
+        if (port && port->m_port_id == lanes->second)
         {
             SWSS_LOG_INFO("Port has already been initialized before alias:%s", alias.c_str());
+            continue;
         }
-        else
-        {
-            Port p(alias, Port::PHY);
 
-            p.m_index = static_cast<int32_t>(m_portList.size()); // TODO: Assume no deletion of physical port
-            p.m_port_id = id;
+        Port p(alias, Port::PHY);
+        p.m_port_id = lanes->second;
+        ports.push_back(p);
+    }
 
-            /* Initialize the port and create corresponding host interface */
-            if (initializePort(p))
-            {
-                /* Add port to port list */
-                m_portList[alias] = p;
-                /* Add port name map to counter table */
-                FieldValueTuple tuple(p.m_alias, sai_serialize_object_id(p.m_port_id));
-                vector<FieldValueTuple> fields;
-                fields.push_back(tuple);
-                m_counterTable->set("", fields);
-
-                /* Add port to flex_counter for updating stat counters  */
-                string key = getPortFlexCounterTableKey(sai_serialize_object_id(p.m_port_id));
-                std::string delimiter = "";
-                std::ostringstream counters_stream;
-                for (const auto &id: portStatIds)
-                {
-                    counters_stream << delimiter << sai_serialize_port_stat(id);
-                    delimiter = ",";
-                }
+    if (ports.empty())
+    {
+        return true;
+    }
 
-                fields.clear();
-                fields.emplace_back(PORT_COUNTER_ID_LIST, counters_stream.str());
+    /*
+     * Each SAI get is a synchronous round trip to syncd. The attributes of
+     * the ports are queried in two gets per port, the counts and then the
+     * lists of queues and priority groups, ahead of the per port work.
+     */
+    auto start = chrono::steady_clock::now();
+    auto last = start;
+    auto phase = [&last]()
+    {
+        auto now = chrono::steady_clock::now();
+        auto ms = chrono::duration_cast<chrono::milliseconds>(now - last).count();
+        last = now;
+        return (long)ms;
+    };
 
-                m_flexCounterTable->set(key, fields);
+    getQueueCounts(ports);
+    long counts_ms = phase();
 
-    		PortUpdate update = {p, true };
-    		notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
+    getQueueLists(ports);
+    long lists_ms = phase();
 
-                SWSS_LOG_NOTICE("Initialized port %s", alias.c_str());
-            }
-            else
-            {
-                SWSS_LOG_ERROR("Failed to initialize port %s", alias.c_str());
-                return false;
-            }
+    for (auto &p : ports)
+    {
+        /* Initialize the port and create corresponding host interface */
+        if (!initializePort(p))
+        {
+            SWSS_LOG_ERROR("Failed to initialize port %s", p.m_alias.c_str());
+            return false;
         }
     }
-    else
+    long hostif_ms = phase();
+
+    /*
+     * The port name map entries are written with one HSET and the port flex
+     * counters are registered with one pipeline flush.
+     */
+    vector<FieldValueTuple> port_names;
+
+    std::string delimiter = "";
+    std::ostringstream counters_stream;
+    for (const auto &id: portStatIds)
     {
-        SWSS_LOG_ERROR("Failed to locate port lane combination alias:%s", alias.c_str());
-        return false;
+        counters_stream << delimiter << sai_serialize_port_stat(id);
+        delimiter = ",";
+    }
+
+    for (auto &p : ports)
+    {
+        p.m_index = static_cast<int32_t>(m_portList.size()); // TODO: Assume no deletion of physical port
+
+        /* Add port to port list */
+        setPort(p.m_alias, p);
+        /* Add port name map to counter table */
+        port_names.emplace_back(p.m_alias, sai_serialize_object_id(p.m_port_id));
+
+        /* Add port to flex_counter for updating stat counters  */
+        string key = getPortFlexCounterTableKey(sai_serialize_object_id(p.m_port_id));
+        vector<FieldValueTuple> fields;
+        fields.emplace_back(PORT_COUNTER_ID_LIST, counters_stream.str());
+
+        m_flexCounterTable->set(key, fields);
     }
 
+    m_counterTable->set("", port_names);
+    m_flexCounterTable->flush();
+
+    for (auto &p : ports)
+    {
+        PortUpdate update = {p, true };
+        notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
+
+        SWSS_LOG_NOTICE("Initialized port %s", p.m_alias.c_str());
+    }
+    long counters_ms = phase();
+
+    SWSS_LOG_NOTICE("Initialized %zu ports in %ld ms: queue counts %ld ms, queue lists %ld ms, "
+            "host interfaces %ld ms, counters %ld ms", ports.size(),
+            (long)chrono::duration_cast<chrono::milliseconds>(last - start).count(),
+            counts_ms, lists_ms, hostif_ms, counters_ms);
+
     return true;
 }
 
@@ -1311,6 +1387,8 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     }
                 }
 
+                /* Ports are initialized together once all of them are created */
+                vector<pair<string, set<int>>> port_lanes;
                 for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end();)
                 {
                     bool port_created = false;
@@ -1341,14 +1419,16 @@ void PortsOrch::doPortTask(Consumer &consumer)
 
                     if (port_created)
                     {
-                        if (!initPort(get<0>(it->second), it->first))
-                        {
-                            throw runtime_error("PortsOrch initialization failure.");
-                        }
+                        port_lanes.emplace_back(get<0>(it->second), it->first);
                     }
 
                     it = m_lanesAliasSpeedMap.erase(it);
                 }
+
+                if (!initPorts(port_lanes))
+                {
+                    throw runtime_error("PortsOrch initialization failure.");
+                }
             }
 
             if (!m_portConfigDone)
@@ -1360,7 +1440,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
             if (alias != "PortConfigDone" && !gBufferOrch->isPortReady(alias))
             {
                 // buffer configuration hasn't been applied yet. save it for future retry
-                it++;
+                it = consumer.addToRetry(it, Constraint(RETRY_CST_PORT_READY, alias));
                 continue;
             }
 
@@ -1377,7 +1457,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     {
                         SWSS_LOG_NOTICE("Set port %s AutoNeg to %u", alias.c_str(), an);
                         p.m_autoneg = an;
-                        m_portList[alias] = p;
+                        setPort(alias, p);
 
                         /* Once AN is changed, need to reset the port speed or
                            port adv speed accordingly */
@@ -1405,7 +1485,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 if (speed != 0)
                 {
                     p.m_speed = speed;
-                    m_portList[alias] = p;
+                    setPort(alias, p);
 
                     if (p.m_autoneg)
                     {
@@ -1465,7 +1545,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     if (setPortMtu(p.m_port_id, mtu))
                     {
                         p.m_mtu = mtu;
-                        m_portList[alias] = p;
+                        setPort(alias, p);
                         SWSS_LOG_NOTICE("Set port %s MTU to %u", alias.c_str(), mtu);
                     }
                     else
@@ -1501,7 +1581,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                             p.m_fec_mode = fec_mode_map[fec_mode];
                             if (setPortFec(p.m_port_id, p.m_fec_mode))
                             {
-                                m_portList[alias] = p;
+                                setPort(alias, p);
                                 SWSS_LOG_NOTICE("Set port %s fec to %s", alias.c_str(), fec_mode.c_str());
                             }
                             else
@@ -1595,6 +1675,12 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    /* VLAN members queued in this pass, with the contexts used to reconcile
+     * their statuses once the bulkers are flushed */
+    std::deque<std::pair<SyncMap::iterator, VlanMemberBulkContext>> toAdd;
+    /* Bridge ports created in this pass for the queued members */
+    map<string, BridgePortBulkContext> bridgePorts;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -1631,17 +1717,18 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
         string op = kfvOp(t);
 
         assert(m_portList.find(vlan_alias) != m_portList.end());
-        Port vlan, port;
 
         /* When VLAN member is to be created before VLAN is created */
-        if (!getPort(vlan_alias, vlan))
+        const Port *vlan = findPort(vlan_alias);
+        if (!vlan)
         {
             SWSS_LOG_INFO("Failed to locate VLAN %s", vlan_alias.c_str());
             it++;
             continue;
         }
 
-        if (!getPort(port_alias, port))
+        const Port *port = findPort(port_alias);
+        if (!port)
         {
             SWSS_LOG_ERROR("Failed to locate port %s", port_alias.c_str());
             it = consumer.m_toSync.erase(it);
@@ -1658,9 +1745,14 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
                     tagging_mode = fvValue(i);
             }
 
-            if (tagging_mode != "untagged" &&
-                tagging_mode != "tagged"   &&
-                tagging_mode != "priority_tagged")
+            sai_vlan_tagging_mode_t sai_tagging_mode;
+            if (tagging_mode == "untagged")
+                sai_tagging_mode = SAI_VLAN_TAGGING_MODE_UNTAGGED;
+            else if (tagging_mode == "tagged")
+                sai_tagging_mode = SAI_VLAN_TAGGING_MODE_TAGGED;
+            else if (tagging_mode == "priority_tagged")
+                sai_tagging_mode = SAI_VLAN_TAGGING_MODE_PRIORITY_TAGGED;
+            else
             {
                 SWSS_LOG_ERROR("Wrong tagging_mode '%s' for key: %s", tagging_mode.c_str(), kfvKey(t).c_str());
                 it = consumer.m_toSync.erase(it);
@@ -1668,26 +1760,38 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
             }
 
             /* Duplicate entry */
-            if (vlan.m_members.find(port_alias) != vlan.m_members.end())
+            if (vlan->m_members.find(port_alias) != vlan->m_members.end())
             {
                 it = consumer.m_toSync.erase(it);
                 continue;
             }
 
-            if (addBridgePort(port) && addVlanMember(vlan, port, tagging_mode))
-                it = consumer.m_toSync.erase(it);
-            else
-                it++;
+            /* Create the bridge port of a port once per pass */
+            if (port->m_bridge_port_id == SAI_NULL_OBJECT_ID &&
+                bridgePorts.find(port_alias) == bridgePorts.end())
+            {
+                if (!addBridgePort(*port, bridgePorts[port_alias]))
+                {
+                    bridgePorts.erase(port_alias);
+                    it++;
+                    continue;
+                }
+            }
+
+            toAdd.emplace_back(it, VlanMemberBulkContext(vlan_alias, port_alias, sai_tagging_mode));
+            it++;
         }
         else if (op == DEL_COMMAND)
         {
-            if (vlan.m_members.find(port_alias) != vlan.m_members.end())
+            if (vlan->m_members.find(port_alias) != vlan->m_members.end())
             {
-                if (removeVlanMember(vlan, port))
+                Port v = *vlan;
+                Port p = *port;
+                if (removeVlanMember(v, p))
                 {
-                    if (port.m_vlan_members.empty())
+                    if (p.m_vlan_members.empty())
                     {
-                        removeBridgePort(port);
+                        removeBridgePort(p);
                     }
                     it = consumer.m_toSync.erase(it);
                 }
@@ -1706,6 +1810,40 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    if (toAdd.empty())
+    {
+        return;
+    }
+
+    /* Create the bridge ports, then the members on the ports that have one.
+     * Members whose creation failed stay in m_toSync for retry. */
+    m_bridgePortBulker.flush();
+
+    for (auto& bridgePort : bridgePorts)
+    {
+        addBridgePortPost(bridgePort.first, bridgePort.second);
+    }
+
+    for (auto& entry : toAdd)
+    {
+        const Port *vlan = findPort(entry.second.vlan_alias);
+        const Port *port = findPort(entry.second.port_alias);
+        if (port->m_bridge_port_id != SAI_NULL_OBJECT_ID)
+        {
+            addVlanMember(*vlan, *port, entry.second);
+        }
+    }
+
+    m_vlanMemberBulker.flush();
+
+    for (auto& entry : toAdd)
+    {
+        if (addVlanMemberPost(entry.second))
+        {
+            consumer.m_toSync.erase(entry.first);
+        }
+    }
 }
 
 void PortsOrch::doLagTask(Consumer &consumer)
@@ -1904,73 +2042,68 @@ void PortsOrch::doTask(Consumer &consumer)
     }
 }
 
-void PortsOrch::initializeQueues(Port &port)
+void PortsOrch::getQueueCounts(vector<Port> &ports)
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t attr;
-    attr.id = SAI_PORT_ATTR_QOS_NUMBER_OF_QUEUES;
-    sai_status_t status = sai_port_api->get_port_attribute(port.m_port_id, 1, &attr);
-    if (status != SAI_STATUS_SUCCESS)
+    for (auto &port : ports)
     {
-        SWSS_LOG_ERROR("Failed to get number of queues for port %s rv:%d", port.m_alias.c_str(), status);
-        throw runtime_error("PortsOrch initialization failure.");
-    }
-    SWSS_LOG_INFO("Get %d queues for port %s", attr.value.u32, port.m_alias.c_str());
-
-    port.m_queue_ids.resize(attr.value.u32);
+        sai_attribute_t attrs[2];
+        attrs[0].id = SAI_PORT_ATTR_QOS_NUMBER_OF_QUEUES;
+        attrs[1].id = SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS;
 
-    if (attr.value.u32 == 0)
-    {
-        return;
-    }
-
-    attr.id = SAI_PORT_ATTR_QOS_QUEUE_LIST;
-    attr.value.objlist.count = (uint32_t)port.m_queue_ids.size();
-    attr.value.objlist.list = port.m_queue_ids.data();
+        sai_status_t status = sai_port_api->get_port_attribute(port.m_port_id, 2, attrs);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to get number of queues and priority groups for port %s rv:%d", port.m_alias.c_str(), status);
+            throw runtime_error("PortsOrch initialization failure.");
+        }
+        SWSS_LOG_INFO("Get %d queues and %d priority groups for port %s",
+                attrs[0].value.u32, attrs[1].value.u32, port.m_alias.c_str());
 
-    status = sai_port_api->get_port_attribute(port.m_port_id, 1, &attr);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to get queue list for port %s rv:%d", port.m_alias.c_str(), status);
-        throw runtime_error("PortsOrch initialization failure.");
+        port.m_queue_ids.resize(attrs[0].value.u32);
+        port.m_priority_group_ids.resize(attrs[1].value.u32);
     }
-
-    SWSS_LOG_INFO("Get queues for port %s", port.m_alias.c_str());
 }
 
-void PortsOrch::initializePriorityGroups(Port &port)
+void PortsOrch::getQueueLists(vector<Port> &ports)
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t attr;
-    attr.id = SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS;
-    sai_status_t status = sai_port_api->get_port_attribute(port.m_port_id, 1, &attr);
-    if (status != SAI_STATUS_SUCCESS)
+    for (auto &port : ports)
     {
-        SWSS_LOG_ERROR("Failed to get number of priority groups for port %s rv:%d", port.m_alias.c_str(), status);
-        throw runtime_error("PortsOrch initialization failure.");
-    }
-    SWSS_LOG_INFO("Get %d priority groups for port %s", attr.value.u32, port.m_alias.c_str());
+        vector<sai_attribute_t> attrs;
+        sai_attribute_t attr;
 
-    port.m_priority_group_ids.resize(attr.value.u32);
+        if (!port.m_queue_ids.empty())
+        {
+            attr.id = SAI_PORT_ATTR_QOS_QUEUE_LIST;
+            attr.value.objlist.count = (uint32_t)port.m_queue_ids.size();
+            attr.value.objlist.list = port.m_queue_ids.data();
+            attrs.push_back(attr);
+        }
 
-    if (attr.value.u32 == 0)
-    {
-        return;
-    }
+        if (!port.m_priority_group_ids.empty())
+        {
+            attr.id = SAI_PORT_ATTR_INGRESS_PRIORITY_GROUP_LIST;
+            attr.value.objlist.count = (uint32_t)port.m_priority_group_ids.size();
+            attr.value.objlist.list = port.m_priority_group_ids.data();
+            attrs.push_back(attr);
+        }
 
-    attr.id = SAI_PORT_ATTR_INGRESS_PRIORITY_GROUP_LIST;
-    attr.value.objlist.count = (uint32_t)port.m_priority_group_ids.size();
-    attr.value.objlist.list = port.m_priority_group_ids.data();
+        if (attrs.empty())
+        {
+            continue;
+        }
 
-    status = sai_port_api->get_port_attribute(port.m_port_id, 1, &attr);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Fail to get priority group list for port %s rv:%d", port.m_alias.c_str(), status);
-        throw runtime_error("PortsOrch initialization failure.");
+        sai_status_t status = sai_port_api->get_port_attribute(port.m_port_id, (uint32_t)attrs.size(), attrs.data());
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to get queue and priority group lists for port %s rv:%d", port.m_alias.c_str(), status);
+            throw runtime_error("PortsOrch initialization failure.");
+        }
+        SWSS_LOG_INFO("Get queues and priority groups for port %s", port.m_alias.c_str());
     }
-    SWSS_LOG_INFO("Get priority groups for port %s", port.m_alias.c_str());
 }
 
 bool PortsOrch::initializePort(Port &p)
@@ -1979,9 +2112,6 @@ bool PortsOrch::initializePort(Port &p)
 
     SWSS_LOG_NOTICE("Initializing port alias:%s pid:%lx", p.m_alias.c_str(), p.m_port_id);
 
-    initializePriorityGroups(p);
-    initializeQueues(p);
-
     /* Create host interface */
     addHostIntfs(p, p.m_alias, p.m_hif_id);
 
@@ -2042,15 +2172,11 @@ bool PortsOrch::addHostIntfs(Port &port, string alias, sai_object_id_t &host_int
     return true;
 }
 
-bool PortsOrch::addBridgePort(Port &port)
+/* Queue the creation of the bridge port of a port or LAG */
+bool PortsOrch::addBridgePort(const Port &port, BridgePortBulkContext &ctx)
 {
     SWSS_LOG_ENTER();
 
-    if (port.m_bridge_port_id != SAI_NULL_OBJECT_ID)
-    {
-        return true;
-    }
-
     sai_attribute_t attr;
     vector<sai_attribute_t> attrs;
 
@@ -2080,22 +2206,38 @@ bool PortsOrch::addBridgePort(Port &port)
     attr.value.booldata = true;
     attrs.push_back(attr);
 
-    sai_status_t status = sai_bridge_api->create_bridge_port(&port.m_bridge_port_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
+    m_bridgePortBulker.create_entry(&ctx.status, &ctx.bridge_port_id, (uint32_t)attrs.size(), attrs.data());
+
+    return true;
+}
+
+/*
+ * Reconcile the bulk status of a bridge port queued by addBridgePort().
+ * Return true if the port has its bridge port.
+ */
+bool PortsOrch::addBridgePortPost(const string &alias, BridgePortBulkContext &ctx)
+{
+    SWSS_LOG_ENTER();
+
+    if (ctx.status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to add bridge port %s to default 1Q bridge, rv:%d",
-            port.m_alias.c_str(), status);
+            alias.c_str(), ctx.status);
         return false;
     }
 
+    Port port;
+    getPort(alias, port);
     if (!setHostIntfsStripTag(port, SAI_HOSTIF_VLAN_TAG_KEEP))
     {
         SWSS_LOG_ERROR("Failed to set %s for hostif of port %s",
-                hostif_vlan_tag[SAI_HOSTIF_VLAN_TAG_KEEP], port.m_alias.c_str());
+                hostif_vlan_tag[SAI_HOSTIF_VLAN_TAG_KEEP], alias.c_str());
         return false;
     }
-    m_portList[port.m_alias] = port;
-    SWSS_LOG_NOTICE("Add bridge port %s to default 1Q bridge", port.m_alias.c_str());
+
+    sai_object_id_t bridge_port_id = ctx.bridge_port_id;
+    updatePort(alias, [bridge_port_id](Port &p) { p.m_bridge_port_id = bridge_port_id; });
+    SWSS_LOG_NOTICE("Add bridge port %s to default 1Q bridge", alias.c_str());
 
     return true;
 }
@@ -2144,7 +2286,7 @@ bool PortsOrch::removeBridgePort(Port &port)
 
     SWSS_LOG_NOTICE("Remove bridge port %s from default 1Q bridge", port.m_alias.c_str());
 
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     return true;
 }
 
@@ -2172,7 +2314,7 @@ bool PortsOrch::addVlan(string vlan_alias)
     vlan.m_vlan_info.vlan_oid = vlan_oid;
     vlan.m_vlan_info.vlan_id = vlan_id;
     vlan.m_members = set<string>();
-    m_portList[vlan_alias] = vlan;
+    setPort(vlan_alias, vlan);
 
     return true;
 }
@@ -2199,7 +2341,7 @@ bool PortsOrch::removeVlan(Port vlan)
     SWSS_LOG_NOTICE("Remove VLAN %s vid:%hu", vlan.m_alias.c_str(),
             vlan.m_vlan_info.vlan_id);
 
-    m_portList.erase(vlan.m_alias);
+    erasePort(vlan.m_alias);
 
     return true;
 }
@@ -2220,7 +2362,8 @@ bool PortsOrch::getVlanByVlanId(sai_vlan_id_t vlan_id, Port &vlan)
     return false;
 }
 
-bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode)
+/* Queue the creation of the member of a VLAN on the bridge port of a port */
+void PortsOrch::addVlanMember(const Port &vlan, const Port &port, VlanMemberBulkContext &ctx)
 {
     SWSS_LOG_ENTER();
 
@@ -2235,46 +2378,61 @@ bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode)
     attr.value.oid = port.m_bridge_port_id;
     attrs.push_back(attr);
 
-    sai_vlan_tagging_mode_t sai_tagging_mode = SAI_VLAN_TAGGING_MODE_TAGGED;
     attr.id = SAI_VLAN_MEMBER_ATTR_VLAN_TAGGING_MODE;
-    if (tagging_mode == "untagged")
-        sai_tagging_mode = SAI_VLAN_TAGGING_MODE_UNTAGGED;
-    else if (tagging_mode == "tagged")
-        sai_tagging_mode = SAI_VLAN_TAGGING_MODE_TAGGED;
-    else if (tagging_mode == "priority_tagged")
-        sai_tagging_mode = SAI_VLAN_TAGGING_MODE_PRIORITY_TAGGED;
-    else assert(false);
-    attr.value.s32 = sai_tagging_mode;
+    attr.value.s32 = ctx.tagging_mode;
     attrs.push_back(attr);
 
-    sai_object_id_t vlan_member_id;
-    sai_status_t status = sai_vlan_api->create_vlan_member(&vlan_member_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
+    m_vlanMemberBulker.create_entry(&ctx.status, &ctx.vlan_member_id, (uint32_t)attrs.size(), attrs.data());
+}
+
+/*
+ * Reconcile the bulk status of a VLAN member queued by addVlanMember().
+ * Return true if the member is synced.
+ */
+bool PortsOrch::addVlanMemberPost(VlanMemberBulkContext &ctx)
+{
+    SWSS_LOG_ENTER();
+
+    /* Not queued, the bridge port of the port failed to be created */
+    if (ctx.status == SAI_STATUS_NOT_EXECUTED)
     {
-        SWSS_LOG_ERROR("Failed to add member %s to VLAN %s vid:%hu pid:%lx",
-                port.m_alias.c_str(), vlan.m_alias.c_str(), vlan.m_vlan_info.vlan_id, port.m_port_id);
+        return false;
+    }
+
+    const Port *vlan = findPort(ctx.vlan_alias);
+    Port port = *findPort(ctx.port_alias);
+    sai_vlan_id_t vlan_id = vlan->m_vlan_info.vlan_id;
+
+    if (ctx.status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to add member %s to VLAN %s vid:%hu pid:%lx rv:%d",
+                port.m_alias.c_str(), vlan->m_alias.c_str(), vlan_id, port.m_port_id, ctx.status);
         return false;
     }
     SWSS_LOG_NOTICE("Add member %s to VLAN %s vid:%hu pid%lx",
-            port.m_alias.c_str(), vlan.m_alias.c_str(), vlan.m_vlan_info.vlan_id, port.m_port_id);
+            port.m_alias.c_str(), vlan->m_alias.c_str(), vlan_id, port.m_port_id);
 
     /* Use untagged VLAN as pvid of the member port */
-    if (sai_tagging_mode == SAI_VLAN_TAGGING_MODE_UNTAGGED)
+    if (ctx.tagging_mode == SAI_VLAN_TAGGING_MODE_UNTAGGED)
     {
-        if(!setPortPvid(port, vlan.m_vlan_info.vlan_id))
+        if(!setPortPvid(port, vlan_id))
         {
             return false;
         }
     }
 
     /* a physical port may join multiple vlans */
-    VlanMemberEntry vme = {vlan_member_id, sai_tagging_mode};
-    port.m_vlan_members[vlan.m_vlan_info.vlan_id] = vme;
-    m_portList[port.m_alias] = port;
-    vlan.m_members.insert(port.m_alias);
-    m_portList[vlan.m_alias] = vlan;
+    VlanMemberEntry vme = {ctx.vlan_member_id, ctx.tagging_mode};
+    port.m_vlan_members[vlan_id] = vme;
+    sai_vlan_id_t pvid = port.m_port_vlan_id;
+    updatePort(ctx.port_alias, [vlan_id, vme, pvid](Port &p)
+    {
+        p.m_vlan_members[vlan_id] = vme;
+        p.m_port_vlan_id = pvid;
+    });
+    updatePort(ctx.vlan_alias, [&ctx](Port &p) { p.m_members.insert(ctx.port_alias); });
 
-    VlanMemberUpdate update = { vlan, port, true };
+    VlanMemberUpdate update = { *vlan, port, true };
     notify(SUBJECT_TYPE_VLAN_MEMBER_CHANGE, static_cast<void *>(&update));
 
     return true;
@@ -2313,9 +2471,9 @@ bool PortsOrch::removeVlanMember(Port &vlan, Port &port)
         }
     }
 
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     vlan.m_members.erase(port.m_alias);
-    m_portList[vlan.m_alias] = vlan;
+    setPort(vlan.m_alias, vlan);
 
     VlanMemberUpdate update = { vlan, port, false };
     notify(SUBJECT_TYPE_VLAN_MEMBER_CHANGE, static_cast<void *>(&update));
@@ -2341,7 +2499,7 @@ bool PortsOrch::addLag(string lag_alias)
     Port lag(lag_alias, Port::LAG);
     lag.m_lag_id = lag_id;
     lag.m_members = set<string>();
-    m_portList[lag_alias] = lag;
+    setPort(lag_alias, lag);
 
     return true;
 }
@@ -2371,7 +2529,7 @@ bool PortsOrch::removeLag(Port lag)
 
     SWSS_LOG_NOTICE("Remove LAG %s lid:%lx", lag.m_alias.c_str(), lag.m_lag_id);
 
-    m_portList.erase(lag.m_alias);
+    erasePort(lag.m_alias);
 
     return true;
 }
@@ -2427,10 +2585,10 @@ bool PortsOrch::addLagMember(Port &lag, Port &port)
 
     port.m_lag_id = lag.m_lag_id;
     port.m_lag_member_id = lag_member_id;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     lag.m_members.insert(port.m_alias);
 
-    m_portList[lag.m_alias] = lag;
+    setPort(lag.m_alias, lag);
 
     if (lag.m_bridge_port_id > 0)
     {
@@ -2464,9 +2622,9 @@ bool PortsOrch::removeLagMember(Port &lag, Port &port)
 
     port.m_lag_id = 0;
     port.m_lag_member_id = 0;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     lag.m_members.erase(port.m_alias);
-    m_portList[lag.m_alias] = lag;
+    setPort(lag.m_alias, lag);
 
     if (lag.m_bridge_port_id > 0)
     {
@@ -2490,26 +2648,59 @@ void PortsOrch::generateQueueMap()
         return;
     }
 
+    /*
+     * The maps of all the queues are written with one HSET per map, and the
+     * queue flex counters are registered with one pipeline flush, instead of
+     * a redis round trip per queue.
+     */
+    QueueMaps maps;
+
+    std::string delimiter = "";
+    std::ostringstream counters_stream;
+    for (const auto& it: queueStatIds)
+    {
+        counters_stream << delimiter << sai_serialize_queue_stat(it);
+        delimiter = ",";
+    }
+
     for (const auto& it: m_portList)
     {
         if (it.second.m_type == Port::PHY)
         {
-            generateQueueMapPerPort(it.second);
+            generateQueueMapPerPort(it.second, maps, counters_stream.str());
         }
     }
 
+    m_flexCounterTable->flush();
+
+    if (!maps.names.empty())
+    {
+        m_queueTable->set("", maps.names);
+        m_queuePortTable->set("", maps.ports);
+        m_queueIndexTable->set("", maps.indexes);
+    }
+    if (!maps.types.empty())
+    {
+        m_queueTypeTable->set("", maps.types);
+    }
+
+    for (const auto& it: m_portList)
+    {
+        if (it.second.m_type == Port::PHY)
+        {
+            CounterCheckOrch::getInstance().addPort(it.second);
+        }
+    }
+
+    SWSS_LOG_NOTICE("Generated queue maps of %zu queues", maps.names.size());
+
     m_isQueueMapGenerated = true;
 }
 
-void PortsOrch::generateQueueMapPerPort(const Port& port)
+void PortsOrch::generateQueueMapPerPort(const Port& port, QueueMaps &maps, const string &counters)
 {
     /* Create the Queue map in the Counter DB */
     /* Add stat counters to flex_counter */
-    vector<FieldValueTuple> queueVector;
-    vector<FieldValueTuple> queuePortVector;
-    vector<FieldValueTuple> queueIndexVector;
-    vector<FieldValueTuple> queueTypeVector;
-
     for (size_t queueIndex = 0; queueIndex < port.m_queue_ids.size(); ++queueIndex)
     {
         std::ostringstream name;
@@ -2517,38 +2708,23 @@ void PortsOrch::generateQueueMapPerPort(const Port& port)
 
         const auto id = sai_serialize_object_id(port.m_queue_ids[queueIndex]);
 
-        queueVector.emplace_back(name.str(), id);
-        queuePortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
-        queueIndexVector.emplace_back(id, to_string(queueIndex));
+        maps.names.emplace_back(name.str(), id);
+        maps.ports.emplace_back(id, sai_serialize_object_id(port.m_port_id));
+        maps.indexes.emplace_back(id, to_string(queueIndex));
 
         string queueType;
         if (getQueueType(port.m_queue_ids[queueIndex], queueType))
         {
-            queueTypeVector.emplace_back(id, queueType);
+            maps.types.emplace_back(id, queueType);
         }
 
         string key = getQueueFlexCounterTableKey(id);
 
-        std::string delimiter = "";
-        std::ostringstream counters_stream;
-        for (const auto& it: queueStatIds)
-        {
-            counters_stream << delimiter << sai_serialize_queue_stat(it);
-            delimiter = ",";
-        }
-
         vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(QUEUE_COUNTER_ID_LIST, counters_stream.str());
+        fieldValues.emplace_back(QUEUE_COUNTER_ID_LIST, counters);
 
         m_flexCounterTable->set(key, fieldValues);
     }
-
-    m_queueTable->set("", queueVector);
-    m_queuePortTable->set("", queuePortVector);
-    m_queueIndexTable->set("", queueIndexVector);
-    m_queueTypeTable->set("", queueTypeVector);
-
-    CounterCheckOrch::getInstance().addPort(port);
 }
 
 void PortsOrch::doTask(NotificationConsumer &consumer)
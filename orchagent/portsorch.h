@@ -2,13 +2,16 @@
 #define SWSS_PORTSORCH_H
 
 #include <map>
+#include <deque>
 
 #include "acltable.h"
 #include "orch.h"
 #include "port.h"
+#include "portindex.h"
 #include "observer.h"
 #include "macaddress.h"
 #include "producertable.h"
+#include "bulker.h"
 
 #define FCS_LEN 4
 #define VLAN_TAG_LEN 4
@@ -48,6 +51,32 @@ struct VlanMemberUpdate
     bool add;
 };
 
+struct BridgePortBulkContext
+{
+    sai_status_t        status;             // Bulk status of the bridge port
+    sai_object_id_t     bridge_port_id;     // Bridge port created
+
+    BridgePortBulkContext()
+        : status(SAI_STATUS_NOT_EXECUTED), bridge_port_id(SAI_NULL_OBJECT_ID)
+    {
+    }
+};
+
+struct VlanMemberBulkContext
+{
+    string                  vlan_alias;         // VLAN of the member
+    string                  port_alias;         // Port or LAG joining the VLAN
+    sai_vlan_tagging_mode_t tagging_mode;       // Tagging mode of the member
+    sai_status_t            status;             // Bulk status of the VLAN member
+    sai_object_id_t         vlan_member_id;     // VLAN member created
+
+    VlanMemberBulkContext(const string &vlan_alias, const string &port_alias, sai_vlan_tagging_mode_t tagging_mode)
+        : vlan_alias(vlan_alias), port_alias(port_alias), tagging_mode(tagging_mode),
+          status(SAI_STATUS_NOT_EXECUTED), vlan_member_id(SAI_NULL_OBJECT_ID)
+    {
+    }
+};
+
 class PortsOrch : public Orch, public Subject
 {
 public:
@@ -60,7 +89,32 @@ public:
     bool getPort(string alias, Port &port);
     bool getPort(sai_object_id_t id, Port &port);
     bool getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port);
+    bool getPortByHostIfId(sai_object_id_t hif_id, Port &port);
     void setPort(string alias, Port port);
+
+    /*
+     * Port without copying it, NULL if there is none. The pointer stays valid,
+     * and sees the updates of the port, until the port is removed.
+     */
+    const Port *findPort(const string &alias) const;
+    const Port *findPort(sai_object_id_t id) const;
+    const Port *findPortByBridgePortId(sai_object_id_t bridge_port_id) const;
+
+    /* Change fields of the port in place, return false if there is no such port */
+    template <typename F>
+    bool updatePort(const string &alias, F update)
+    {
+        auto it = m_portList.find(alias);
+        if (it == m_portList.end())
+        {
+            return false;
+        }
+
+        m_portIndex.erase(alias, it->second);
+        update(it->second);
+        m_portIndex.insert(alias, it->second);
+        return true;
+    }
     void getCpuPort(Port &port);
     bool getVlanByVlanId(sai_vlan_id_t vlan_id, Port &vlan);
     bool getAclBindPortId(string alias, sai_object_id_t &port_id);
@@ -77,6 +131,8 @@ private:
     unique_ptr<Table> m_queuePortTable;
     unique_ptr<Table> m_queueIndexTable;
     unique_ptr<Table> m_queueTypeTable;
+    /* Buffered, the counters of a batch of ports or queues are flushed together */
+    unique_ptr<RedisPipeline> m_flexCounterPipeline;
     unique_ptr<ProducerTable> m_flexCounterTable;
     unique_ptr<ProducerTable> m_flexCounterGroupTable;
 
@@ -99,6 +155,8 @@ private:
     map<set<int>, sai_object_id_t> m_portListLaneMap;
     map<set<int>, tuple<string, uint32_t, int, string>> m_lanesAliasSpeedMap;
     map<string, Port> m_portList;
+    /* Port aliases by SAI object id, updated by setPort() and erasePort() */
+    PortIndex m_portIndex;
 
     NotificationConsumer* m_portStatusNotificationConsumer;
 
@@ -111,22 +169,29 @@ private:
 
     void doTask(NotificationConsumer &consumer);
 
+    void erasePort(const string &alias);
+
     void removeDefaultVlanMembers();
     void removeDefaultBridgePorts();
 
     bool initializePort(Port &port);
-    void initializePriorityGroups(Port &port);
-    void initializeQueues(Port &port);
+    void getQueueCounts(vector<Port> &ports);
+    void getQueueLists(vector<Port> &ports);
 
     bool addHostIntfs(Port &port, string alias, sai_object_id_t &host_intfs_id);
     bool setHostIntfsStripTag(Port &port, sai_hostif_vlan_tag_t strip);
 
-    bool addBridgePort(Port &port);
+    ObjectBulker<sai_bridge_api_t> m_bridgePortBulker;
+    ObjectBulker<sai_vlan_api_t> m_vlanMemberBulker;
+
+    bool addBridgePort(const Port &port, BridgePortBulkContext &ctx);
+    bool addBridgePortPost(const string &alias, BridgePortBulkContext &ctx);
     bool removeBridgePort(Port &port);
 
     bool addVlan(string vlan);
     bool removeVlan(Port vlan);
-    bool addVlanMember(Port &vlan, Port &port, string& tagging_mode);
+    void addVlanMember(const Port &vlan, const Port &port, VlanMemberBulkContext &ctx);
+    bool addVlanMemberPost(VlanMemberBulkContext &ctx);
     bool removeVlanMember(Port &vlan, Port &port);
 
     bool addLag(string lag);
@@ -137,7 +202,7 @@ private:
 
     bool addPort(const set<int> &lane_set, uint32_t speed, int an=0, string fec="");
     bool removePort(sai_object_id_t port_id);
-    bool initPort(const string &alias, const set<int> &lane_set);
+    bool initPorts(const vector<pair<string, set<int>>> &port_lanes);
 
     bool setPortAdminStatus(sai_object_id_t id, bool up);
     bool setPortMtu(sai_object_id_t id, sai_uint32_t mtu);
@@ -155,8 +220,17 @@ private:
 
     bool getQueueType(sai_object_id_t queue_id, string &type);
 
+    /* COUNTERS_DB queue maps, built for all the ports before being written */
+    struct QueueMaps
+    {
+        vector<FieldValueTuple> names;
+        vector<FieldValueTuple> ports;
+        vector<FieldValueTuple> indexes;
+        vector<FieldValueTuple> types;
+    };
+
     bool m_isQueueMapGenerated = false;
-    void generateQueueMapPerPort(const Port& port);
+    void generateQueueMapPerPort(const Port& port, QueueMaps &maps, const string &counters);
 
     bool setPortAutoNeg(sai_object_id_t id, int an);
     bool setPortFecMode(sai_object_id_t id, int fec);
@@ -0,0 +1,385 @@
+#ifndef SWSS_PREFIXTRIE_H
+#define SWSS_PREFIXTRIE_H
+
+#include <array>
+#include <algorithm>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+
+#include "ipaddress.h"
+#include "ipprefix.h"
+
+/*
+ * PrefixTrie is a path compressed binary trie (Patricia trie) indexing values
+ * by bit string prefixes of up to 128 bits. Every node keeps its full prefix,
+ * and a node without value exists only where two branches split, so a lookup
+ * visits at most one node per bit of the key.
+ */
+template <typename V>
+class PrefixTrie
+{
+public:
+    static const size_t MAX_KEY_BITS = 128;
+    typedef std::array<uint8_t, MAX_KEY_BITS / 8> Key;
+
+    PrefixTrie() : m_size(0), m_nodes(0)
+    {
+    }
+
+    PrefixTrie(const PrefixTrie&) = delete;
+    PrefixTrie& operator=(const PrefixTrie&) = delete;
+
+    bool empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
+
+    /* Heap memory used by the trie nodes */
+    size_t memoryUsage() const { return m_nodes * sizeof(Node); }
+
+    /* Set the value of the prefix, the bits beyond its length must be zero */
+    void insert(const Key &key, size_t len, const V &value)
+    {
+        std::unique_ptr<Node> *node = &m_root;
+
+        while (true)
+        {
+            if (!*node)
+            {
+                node->reset(new Node(key, len));
+                m_nodes++;
+                setValue(**node, value);
+                return;
+            }
+
+            Node &n = **node;
+            size_t common = commonLength(n.key, key, std::min(n.len, len));
+
+            if (common == n.len)
+            {
+                if (len == n.len)
+                {
+                    setValue(n, value);
+                    return;
+                }
+
+                node = &n.children[bit(key, n.len)];
+                continue;
+            }
+
+            /* Split the branch where the prefix diverges from the node */
+            std::unique_ptr<Node> parent(new Node(key, common));
+            m_nodes++;
+            bool old_bit = bit(n.key, common);
+            parent->children[old_bit] = std::move(*node);
+
+            if (common == len)
+            {
+                setValue(*parent, value);
+            }
+            else
+            {
+                parent->children[!old_bit].reset(new Node(key, len));
+                m_nodes++;
+                setValue(*parent->children[!old_bit], value);
+            }
+
+            *node = std::move(parent);
+            return;
+        }
+    }
+
+    /* Return the value of the prefix, or NULL if it is not in the trie */
+    V *find(const Key &key, size_t len)
+    {
+        Node *node = m_root.get();
+
+        while (node && node->len <= len && commonLength(node->key, key, node->len) == node->len)
+        {
+            if (node->len == len)
+            {
+                return node->has_value ? &node->value : nullptr;
+            }
+
+            node = node->children[bit(key, node->len)].get();
+        }
+
+        return nullptr;
+    }
+
+    /* Remove the prefix, return false if it is not in the trie */
+    bool erase(const Key &key, size_t len)
+    {
+        return erase(m_root, key, len);
+    }
+
+    /* Visit the values of the prefixes containing the key, shortest first */
+    template <typename F>
+    void visitCovering(const Key &key, size_t len, F visit)
+    {
+        Node *node = m_root.get();
+
+        while (node && node->len <= len && commonLength(node->key, key, node->len) == node->len)
+        {
+            if (node->has_value)
+            {
+                visit(node->value);
+            }
+
+            if (node->len == len)
+            {
+                return;
+            }
+
+            node = node->children[bit(key, node->len)].get();
+        }
+    }
+
+    /* Visit the values of the prefixes contained in the key, including itself */
+    template <typename F>
+    void visitCovered(const Key &key, size_t len, F visit)
+    {
+        Node *node = m_root.get();
+
+        while (node)
+        {
+            if (node->len >= len)
+            {
+                if (commonLength(node->key, key, len) == len)
+                {
+                    visitAll(*node, visit);
+                }
+                return;
+            }
+
+            if (commonLength(node->key, key, node->len) != node->len)
+            {
+                return;
+            }
+
+            node = node->children[bit(key, node->len)].get();
+        }
+    }
+
+private:
+    struct Node
+    {
+        Key key;
+        size_t len;
+        bool has_value;
+        V value;
+        std::unique_ptr<Node> children[2];
+
+        Node(const Key &k, size_t l) : len(l), has_value(false), value()
+        {
+            /* Keep only the first l bits of the key */
+            key.fill(0);
+            std::memcpy(key.data(), k.data(), l / 8);
+            if (l % 8)
+            {
+                key[l / 8] = static_cast<uint8_t>(k[l / 8] & (0xff << (8 - l % 8)));
+            }
+        }
+    };
+
+    std::unique_ptr<Node> m_root;
+    size_t m_size;
+    size_t m_nodes;
+
+    static bool bit(const Key &key, size_t pos)
+    {
+        return (key[pos / 8] >> (7 - pos % 8)) & 1;
+    }
+
+    /* Length of the common prefix of the keys, up to max bits */
+    static size_t commonLength(const Key &a, const Key &b, size_t max)
+    {
+        size_t len = 0;
+
+        while (len < max)
+        {
+            uint8_t diff = static_cast<uint8_t>(a[len / 8] ^ b[len / 8]);
+            if (diff == 0)
+            {
+                len += 8;
+                continue;
+            }
+
+            while (!(diff & 0x80))
+            {
+                diff = static_cast<uint8_t>(diff << 1);
+                len++;
+            }
+            break;
+        }
+
+        return std::min(len, max);
+    }
+
+    void setValue(Node &node, const V &value)
+    {
+        if (!node.has_value)
+        {
+            node.has_value = true;
+            m_size++;
+        }
+        node.value = value;
+    }
+
+    bool erase(std::unique_ptr<Node> &node, const Key &key, size_t len)
+    {
+        if (!node || node->len > len || commonLength(node->key, key, node->len) != node->len)
+        {
+            return false;
+        }
+
+        if (node->len == len)
+        {
+            if (!node->has_value)
+            {
+                return false;
+            }
+
+            node->has_value = false;
+            node->value = V();
+            m_size--;
+        }
+        else if (!erase(node->children[bit(key, node->len)], key, len))
+        {
+            return false;
+        }
+
+        /* Remove the nodes without value that no longer split two branches */
+        if (!node->has_value && !(node->children[0] && node->children[1]))
+        {
+            std::unique_ptr<Node> child = std::move(node->children[node->children[0] ? 0 : 1]);
+            node = std::move(child);
+            m_nodes--;
+        }
+
+        return true;
+    }
+
+    template <typename F>
+    static void visitAll(Node &node, F &visit)
+    {
+        if (node.has_value)
+        {
+            visit(node.value);
+        }
+
+        for (auto &child : node.children)
+        {
+            if (child)
+            {
+                visitAll(*child, visit);
+            }
+        }
+    }
+};
+
+/* PrefixTrie of IPv4 and IPv6 prefixes */
+template <typename V>
+class IpPrefixTrie
+{
+public:
+    typedef typename PrefixTrie<V>::Key Key;
+
+    bool empty() const { return m_v4.empty() && m_v6.empty(); }
+    size_t size() const { return m_v4.size() + m_v6.size(); }
+    size_t memoryUsage() const { return m_v4.memoryUsage() + m_v6.memoryUsage(); }
+
+    void insert(const swss::IpPrefix &prefix, const V &value)
+    {
+        Key key;
+        size_t len = toKey(prefix, key);
+        trie(prefix.isV4()).insert(key, len, value);
+    }
+
+    /* Index a host address as a full length prefix */
+    void insert(const swss::IpAddress &addr, const V &value)
+    {
+        Key key;
+        size_t len = toKey(addr, key);
+        trie(addr.isV4()).insert(key, len, value);
+    }
+
+    V *find(const swss::IpPrefix &prefix)
+    {
+        Key key;
+        size_t len = toKey(prefix, key);
+        return trie(prefix.isV4()).find(key, len);
+    }
+
+    bool erase(const swss::IpPrefix &prefix)
+    {
+        Key key;
+        size_t len = toKey(prefix, key);
+        return trie(prefix.isV4()).erase(key, len);
+    }
+
+    bool erase(const swss::IpAddress &addr)
+    {
+        Key key;
+        size_t len = toKey(addr, key);
+        return trie(addr.isV4()).erase(key, len);
+    }
+
+    /* Visit the values of the prefixes the address belongs to, shortest first */
+    template <typename F>
+    void visitCovering(const swss::IpAddress &addr, F visit)
+    {
+        Key key;
+        size_t len = toKey(addr, key);
+        trie(addr.isV4()).visitCovering(key, len, visit);
+    }
+
+    /* Visit the values of the prefixes and addresses within the prefix */
+    template <typename F>
+    void visitCovered(const swss::IpPrefix &prefix, F visit)
+    {
+        Key key;
+        size_t len = toKey(prefix, key);
+        trie(prefix.isV4()).visitCovered(key, len, visit);
+    }
+
+private:
+    PrefixTrie<V> m_v4;
+    PrefixTrie<V> m_v6;
+
+    PrefixTrie<V>& trie(bool v4)
+    {
+        return v4 ? m_v4 : m_v6;
+    }
+
+    static size_t toKey(const swss::IpAddress &addr, Key &key)
+    {
+        key.fill(0);
+
+        swss::ip_addr_t ip = addr.getIp();
+        if (addr.isV4())
+        {
+            /* The IPv4 address is kept in network byte order */
+            std::memcpy(key.data(), &ip.ip_addr.ipv4_addr, 4);
+            return 32;
+        }
+
+        std::memcpy(key.data(), ip.ip_addr.ipv6_addr, 16);
+        return 128;
+    }
+
+    static size_t toKey(const swss::IpPrefix &prefix, Key &key)
+    {
+        toKey(prefix.getIp(), key);
+
+        /* Clear the host bits */
+        size_t len = static_cast<size_t>(prefix.getMaskLength());
+        for (size_t i = len; i < PrefixTrie<V>::MAX_KEY_BITS; i++)
+        {
+            key[i / 8] = static_cast<uint8_t>(key[i / 8] & ~(0x80 >> (i % 8)));
+        }
+
+        return len;
+    }
+};
+
+#endif /* SWSS_PREFIXTRIE_H */
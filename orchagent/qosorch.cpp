@@ -54,13 +54,11 @@ type_map QosOrch::m_qos_maps = {
     {CFG_PFC_PRIORITY_TO_QUEUE_MAP_TABLE_NAME, new object_map()}
 };
 
-task_process_status QosMapHandler::processWorkItem(Consumer& consumer)
+task_process_status QosMapHandler::processWorkItem(Consumer& consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
 
     sai_object_id_t sai_object = SAI_NULL_OBJECT_ID;
-    auto it = consumer.m_toSync.begin();
-    KeyOpFieldsValuesTuple tuple = it->second;
     string qos_object_name = kfvKey(tuple);
     string qos_map_type_name = consumer.getTableName();
     string op = kfvOp(tuple);
@@ -202,11 +200,11 @@ sai_object_id_t DscpToTcMapHandler::addQosItem(const vector<sai_attribute_t> &at
     return sai_object;
 }
 
-task_process_status QosOrch::handleDscpToTcTable(Consumer& consumer)
+task_process_status QosOrch::handleDscpToTcTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
     DscpToTcMapHandler dscp_tc_handler;
-    return dscp_tc_handler.processWorkItem(consumer);
+    return dscp_tc_handler.processWorkItem(consumer, tuple);
 }
 
 bool TcToQueueMapHandler::convertFieldValuesToAttributes(KeyOpFieldsValuesTuple &tuple, vector<sai_attribute_t> &attributes)
@@ -255,11 +253,11 @@ sai_object_id_t TcToQueueMapHandler::addQosItem(const vector<sai_attribute_t> &a
     return sai_object;
 }
 
-task_process_status QosOrch::handleTcToQueueTable(Consumer& consumer)
+task_process_status QosOrch::handleTcToQueueTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
     TcToQueueMapHandler tc_queue_handler;
-    return tc_queue_handler.processWorkItem(consumer);
+    return tc_queue_handler.processWorkItem(consumer, tuple);
 }
 
 void WredMapHandler::freeAttribResources(vector<sai_attribute_t> &attributes)
@@ -433,11 +431,11 @@ bool WredMapHandler::removeQosItem(sai_object_id_t sai_object)
     return true;
 }
 
-task_process_status QosOrch::handleWredProfileTable(Consumer& consumer)
+task_process_status QosOrch::handleWredProfileTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
     WredMapHandler wred_handler;
-    return wred_handler.processWorkItem(consumer);
+    return wred_handler.processWorkItem(consumer, tuple);
 }
 
 bool TcToPgHandler::convertFieldValuesToAttributes(KeyOpFieldsValuesTuple &tuple, vector<sai_attribute_t> &attributes)
@@ -486,11 +484,11 @@ sai_object_id_t TcToPgHandler::addQosItem(const vector<sai_attribute_t> &attribu
 
 }
 
-task_process_status QosOrch::handleTcToPgTable(Consumer& consumer)
+task_process_status QosOrch::handleTcToPgTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
     TcToPgHandler tc_to_pg_handler;
-    return tc_to_pg_handler.processWorkItem(consumer);
+    return tc_to_pg_handler.processWorkItem(consumer, tuple);
 }
 
 bool PfcPrioToPgHandler::convertFieldValuesToAttributes(KeyOpFieldsValuesTuple &tuple, vector<sai_attribute_t> &attributes)
@@ -540,11 +538,11 @@ sai_object_id_t PfcPrioToPgHandler::addQosItem(const vector<sai_attribute_t> &at
 
 }
 
-task_process_status QosOrch::handlePfcPrioToPgTable(Consumer& consumer)
+task_process_status QosOrch::handlePfcPrioToPgTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
     PfcPrioToPgHandler pfc_prio_to_pg_handler;
-    return pfc_prio_to_pg_handler.processWorkItem(consumer);
+    return pfc_prio_to_pg_handler.processWorkItem(consumer, tuple);
 }
 
 bool PfcToQueueHandler::convertFieldValuesToAttributes(KeyOpFieldsValuesTuple &tuple, vector<sai_attribute_t> &attributes)
@@ -595,11 +593,11 @@ sai_object_id_t PfcToQueueHandler::addQosItem(const vector<sai_attribute_t> &att
 
 }
 
-task_process_status QosOrch::handlePfcToQueueTable(Consumer& consumer)
+task_process_status QosOrch::handlePfcToQueueTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
     PfcToQueueHandler pfc_to_queue_handler;
-    return pfc_to_queue_handler.processWorkItem(consumer);
+    return pfc_to_queue_handler.processWorkItem(consumer, tuple);
 }
 
 QosOrch::QosOrch(DBConnector *db, vector<string> &tableNames) : Orch(db, tableNames)
@@ -761,14 +759,13 @@ void QosOrch::initTableHandlers()
     m_qos_handler_map.insert(qos_handler_pair(CFG_PFC_PRIORITY_TO_QUEUE_MAP_TABLE_NAME, &QosOrch::handlePfcToQueueTable));
 }
 
-task_process_status QosOrch::handleSchedulerTable(Consumer& consumer)
+task_process_status QosOrch::handleSchedulerTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
 
     sai_status_t sai_status;
     sai_object_id_t sai_object = SAI_NULL_OBJECT_ID;
 
-    KeyOpFieldsValuesTuple tuple = consumer.m_toSync.begin()->second;
     string qos_map_type_name = CFG_SCHEDULER_TABLE_NAME;
     string qos_object_name = kfvKey(tuple);
     string op = kfvOp(tuple);
@@ -964,7 +961,7 @@ sai_object_id_t QosOrch::getSchedulerGroup(const Port &port, const sai_object_id
     return SAI_NULL_OBJECT_ID;
 }
 
-bool QosOrch::applySchedulerToQueueSchedulerGroup(Port &port, size_t queue_ind, sai_object_id_t scheduler_profile_id)
+bool QosOrch::applySchedulerToQueueSchedulerGroup(const Port &port, size_t queue_ind, sai_object_id_t scheduler_profile_id)
 {
     SWSS_LOG_ENTER();
 
@@ -1002,7 +999,7 @@ bool QosOrch::applySchedulerToQueueSchedulerGroup(Port &port, size_t queue_ind,
     return true;
 }
 
-bool QosOrch::applyWredProfileToQueue(Port &port, size_t queue_ind, sai_object_id_t sai_wred_profile)
+bool QosOrch::applyWredProfileToQueue(const Port &port, size_t queue_ind, sai_object_id_t sai_wred_profile)
 {
     SWSS_LOG_ENTER();
     sai_attribute_t attr;
@@ -1027,12 +1024,9 @@ bool QosOrch::applyWredProfileToQueue(Port &port, size_t queue_ind, sai_object_i
     return true;
 }
 
-task_process_status QosOrch::handleQueueTable(Consumer& consumer)
+task_process_status QosOrch::handleQueueTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
-    auto it = consumer.m_toSync.begin();
-    KeyOpFieldsValuesTuple tuple = it->second;
-    Port port;
     bool result;
     string key = kfvKey(tuple);
     string op = kfvOp(tuple);
@@ -1056,11 +1050,11 @@ task_process_status QosOrch::handleQueueTable(Consumer& consumer)
         SWSS_LOG_ERROR("Failed to parse range:%s", tokens[1].c_str());
         return task_process_status::task_invalid_entry;
     }
-    for (string port_name : port_names)
+    for (const string &port_name : port_names)
     {
-        Port port;
         SWSS_LOG_DEBUG("processing port:%s", port_name.c_str());
-        if (!gPortsOrch->getPort(port_name, port))
+        const Port *port = gPortsOrch->findPort(port_name);
+        if (!port)
         {
             SWSS_LOG_ERROR("Port with alias:%s not found", port_name.c_str());
             return task_process_status::task_invalid_entry;
@@ -1076,12 +1070,12 @@ task_process_status QosOrch::handleQueueTable(Consumer& consumer)
             {
                 if (op == SET_COMMAND)
                 {
-                    result = applySchedulerToQueueSchedulerGroup(port, queue_ind, sai_scheduler_profile);
+                    result = applySchedulerToQueueSchedulerGroup(*port, queue_ind, sai_scheduler_profile);
                 }
                 else if (op == DEL_COMMAND)
                 {
                     // NOTE: The map is un-bound from the port. But the map itself still exists.
-                    result = applySchedulerToQueueSchedulerGroup(port, queue_ind, SAI_NULL_OBJECT_ID);
+                    result = applySchedulerToQueueSchedulerGroup(*port, queue_ind, SAI_NULL_OBJECT_ID);
                 }
                 else
                 {
@@ -1090,7 +1084,7 @@ task_process_status QosOrch::handleQueueTable(Consumer& consumer)
                 }
                 if (!result)
                 {
-                    SWSS_LOG_ERROR("Failed setting field:%s to port:%s, queue:%zd, line:%d", scheduler_field_name.c_str(), port.m_alias.c_str(), queue_ind, __LINE__);
+                    SWSS_LOG_ERROR("Failed setting field:%s to port:%s, queue:%zd, line:%d", scheduler_field_name.c_str(), port->m_alias.c_str(), queue_ind, __LINE__);
                     return task_process_status::task_failed;
                 }
                 SWSS_LOG_DEBUG("Applied scheduler to port:%s", port_name.c_str());
@@ -1112,12 +1106,12 @@ task_process_status QosOrch::handleQueueTable(Consumer& consumer)
             {
                 if (op == SET_COMMAND)
                 {
-                    result = applyWredProfileToQueue(port, queue_ind, sai_wred_profile);
+                    result = applyWredProfileToQueue(*port, queue_ind, sai_wred_profile);
                 }
                 else if (op == DEL_COMMAND)
                 {
                     // NOTE: The map is un-bound from the port. But the map itself still exists.
-                    result = applyWredProfileToQueue(port, queue_ind, SAI_NULL_OBJECT_ID);
+                    result = applyWredProfileToQueue(*port, queue_ind, SAI_NULL_OBJECT_ID);
                 }
                 else
                 {
@@ -1126,7 +1120,7 @@ task_process_status QosOrch::handleQueueTable(Consumer& consumer)
                 }
                 if (!result)
                 {
-                    SWSS_LOG_ERROR("Failed setting field:%s to port:%s, queue:%zd, line:%d", wred_profile_field_name.c_str(), port.m_alias.c_str(), queue_ind, __LINE__);
+                    SWSS_LOG_ERROR("Failed setting field:%s to port:%s, queue:%zd, line:%d", wred_profile_field_name.c_str(), port->m_alias.c_str(), queue_ind, __LINE__);
                     return task_process_status::task_failed;
                 }
                 SWSS_LOG_DEBUG("Applied wred profile to port:%s", port_name.c_str());
@@ -1213,11 +1207,10 @@ task_process_status QosOrch::ResolveMapAndApplyToPort(
     return task_process_status::task_success;
 }
 
-task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer)
+task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple)
 {
     SWSS_LOG_ENTER();
 
-    KeyOpFieldsValuesTuple tuple = consumer.m_toSync.begin()->second;
     string key = kfvKey(tuple);
     string op = kfvOp(tuple);
 
@@ -1254,12 +1247,11 @@ task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer)
     }
 
     vector<string> port_names = tokenize(key, list_item_delimiter);
-    for (string port_name : port_names)
+    for (const string &port_name : port_names)
     {
-        Port port;
-
         /* Skip port which is not found */
-        if (!gPortsOrch->getPort(port_name, port))
+        const Port *port = gPortsOrch->findPort(port_name);
+        if (!port)
         {
             SWSS_LOG_ERROR("Failed to apply QoS maps to port %s. Port is not found.", port_name.c_str());
             continue;
@@ -1272,7 +1264,7 @@ task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer)
             attr.id = it->first;
             attr.value.oid = it->second.second;
 
-            sai_status_t status = sai_port_api->set_port_attribute(port.m_port_id, &attr);
+            sai_status_t status = sai_port_api->set_port_attribute(port->m_port_id, &attr);
             if (status != SAI_STATUS_SUCCESS)
             {
                 SWSS_LOG_ERROR("Failed to apply %s to port %s, rv:%d",
@@ -1288,7 +1280,7 @@ task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer)
             attr.id = SAI_PORT_ATTR_PRIORITY_FLOW_CONTROL;
             attr.value.u8 = pfc_enable;
 
-            sai_status_t status = sai_port_api->set_port_attribute(port.m_port_id, &attr);
+            sai_status_t status = sai_port_api->set_port_attribute(port->m_port_id, &attr);
             if (status != SAI_STATUS_SUCCESS)
             {
                 SWSS_LOG_ERROR("Failed to apply PFC bits 0x%x to port %s, rv:%d",
@@ -1302,6 +1294,7 @@ task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer)
     return task_process_status::task_success;
 }
 
+/* Tasks waiting for a referenced QoS object are retried in the next pass */
 void QosOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
@@ -1323,7 +1316,7 @@ void QosOrch::doTask(Consumer &consumer)
             continue;
         }
 
-        auto task_status = (this->*(m_qos_handler_map[qos_map_type_name]))(consumer);
+        auto task_status = (this->*(m_qos_handler_map[qos_map_type_name]))(consumer, it->second);
         switch(task_status)
         {
             case task_process_status::task_success :
@@ -1336,7 +1329,7 @@ void QosOrch::doTask(Consumer &consumer)
             case task_process_status::task_failed :
                 SWSS_LOG_ERROR("Failed to process QOS task, drop it");
                 it = consumer.m_toSync.erase(it);
-                return;
+                break;
             case task_process_status::task_need_retry :
                 SWSS_LOG_INFO("Failed to process QOS task, retry it");
                 it++;
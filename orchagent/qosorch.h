@@ -46,7 +46,7 @@ const string ecn_all                           = "ecn_all";
 class QosMapHandler
 {
 public:
-    task_process_status processWorkItem(Consumer& consumer);
+    task_process_status processWorkItem(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
     virtual bool convertFieldValuesToAttributes(KeyOpFieldsValuesTuple &tuple, vector<sai_attribute_t> &attributes) = 0;
     virtual void freeAttribResources(vector<sai_attribute_t> &attributes);
     virtual bool modifyQosItem(sai_object_id_t, vector<sai_attribute_t> &attributes);
@@ -113,7 +113,7 @@ public:
 private:
     virtual void doTask(Consumer& consumer);
 
-    typedef task_process_status (QosOrch::*qos_table_handler)(Consumer& consumer);
+    typedef task_process_status (QosOrch::*qos_table_handler)(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
     typedef map<string, qos_table_handler> qos_table_handler_map;
     typedef pair<string, qos_table_handler> qos_handler_pair;
 
@@ -124,21 +124,21 @@ private:
 
     void initTableHandlers();
 
-    task_process_status handleDscpToTcTable(Consumer& consumer);
-    task_process_status handlePfcPrioToPgTable(Consumer& consumer);
-    task_process_status handlePfcToQueueTable(Consumer& consumer);
-    task_process_status handlePortQosMapTable(Consumer& consumer);
-    task_process_status handleTcToPgTable(Consumer& consumer);
-    task_process_status handleTcToQueueTable(Consumer& consumer);
-    task_process_status handleSchedulerTable(Consumer& consumer);
-    task_process_status handleQueueTable(Consumer& consumer);
-    task_process_status handleWredProfileTable(Consumer& consumer);
+    task_process_status handleDscpToTcTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status handlePfcPrioToPgTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status handlePfcToQueueTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status handlePortQosMapTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status handleTcToPgTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status handleTcToQueueTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status handleSchedulerTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status handleQueueTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
+    task_process_status handleWredProfileTable(Consumer& consumer, KeyOpFieldsValuesTuple &tuple);
 
     sai_object_id_t getSchedulerGroup(const Port &port, const sai_object_id_t queue_id);
 
     bool applyMapToPort(Port &port, sai_attr_id_t attr_id, sai_object_id_t sai_dscp_to_tc_map);
-    bool applySchedulerToQueueSchedulerGroup(Port &port, size_t queue_ind, sai_object_id_t scheduler_profile_id);
-    bool applyWredProfileToQueue(Port &port, size_t queue_ind, sai_object_id_t sai_wred_profile);
+    bool applySchedulerToQueueSchedulerGroup(const Port &port, size_t queue_ind, sai_object_id_t scheduler_profile_id);
+    bool applyWredProfileToQueue(const Port &port, size_t queue_ind, sai_object_id_t sai_wred_profile);
     task_process_status ResolveMapAndApplyToPort(Port &port,sai_port_attr_t port_attr,
                                                  string field_name, KeyOpFieldsValuesTuple &tuple, string op);
 
@@ -0,0 +1,213 @@
+#ifndef SWSS_RETRYCACHE_H
+#define SWSS_RETRYCACHE_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "table.h"
+#include "syncmap.h"
+
+/* Type of the object a parked task is waiting for */
+enum ConstraintType
+{
+    RETRY_CST_NEXTHOP,          // Next hop IP address
+    RETRY_CST_PORT_READY,       // Port alias whose buffer configuration is applied
+    RETRY_CST_BUFFER_PROFILE,   // Buffer profile name
+};
+
+typedef std::pair<ConstraintType, std::string> Constraint;
+
+struct ConstraintHash
+{
+    size_t operator()(const Constraint &cst) const
+    {
+        return std::hash<std::string>()(cst.second) ^ static_cast<size_t>(cst.first);
+    }
+};
+
+/*
+ * RetryCache parks the tasks of a Consumer that cannot be processed until an
+ * object owned by another orch, the constraint, is created. Parked tasks are
+ * not visited by doTask() until the owner of the object resolves the
+ * constraint with RetryCache::resolveAll(), which re-queues them to m_toSync.
+ */
+class RetryCache
+{
+public:
+    RetryCache()
+    {
+        instances().insert(this);
+    }
+
+    ~RetryCache()
+    {
+        instances().erase(this);
+
+        auto &resolved = resolvedCaches();
+        resolved.erase(std::remove(resolved.begin(), resolved.end(), this), resolved.end());
+    }
+
+    RetryCache(const RetryCache&) = delete;
+    RetryCache& operator=(const RetryCache&) = delete;
+
+    bool empty() const { return m_tasks.empty(); }
+    size_t size() const { return m_tasks.size(); }
+
+    /* Whether a task of the key is parked */
+    bool contains(const std::string &key) const
+    {
+        return m_tasks.find(key) != m_tasks.end();
+    }
+
+    /* Whether parked tasks are ready to be re-queued */
+    bool hasResolved() const { return !m_resolved.empty(); }
+
+    /* Park the task until the constraint is resolved */
+    void insert(const Constraint &cst, swss::KeyOpFieldsValuesTuple &&task)
+    {
+        std::string key = kfvKey(task);
+
+        auto it = m_tasks.find(key);
+        if (it != m_tasks.end())
+        {
+            unwait(it->second.first, key);
+            m_tasks.erase(it);
+        }
+
+        m_waiting[cst].insert(key);
+        m_tasks.emplace(key, std::make_pair(cst, std::move(task)));
+    }
+
+    /* Re-queue the parked task of the key, if any, ahead of the pending one */
+    void restore(const std::string &key, SyncMap &toSync)
+    {
+        if (m_tasks.empty())
+        {
+            return;
+        }
+
+        auto it = m_tasks.find(key);
+        if (it == m_tasks.end())
+        {
+            return;
+        }
+
+        unwait(it->second.first, key);
+        requeue(std::move(it->second.second), toSync);
+        m_tasks.erase(it);
+    }
+
+    /* Mark the tasks waiting for the constraint as ready to be re-queued */
+    void resolve(const Constraint &cst)
+    {
+        auto waiting = m_waiting.find(cst);
+        if (waiting == m_waiting.end())
+        {
+            return;
+        }
+
+        if (m_resolved.empty())
+        {
+            resolvedCaches().push_back(this);
+        }
+
+        m_resolved.insert(m_resolved.end(), waiting->second.begin(), waiting->second.end());
+        m_waiting.erase(waiting);
+    }
+
+    /* Re-queue the tasks whose constraints are resolved, return their keys */
+    std::vector<std::string> restoreResolved(SyncMap &toSync)
+    {
+        std::vector<std::string> restored;
+
+        for (auto &key : m_resolved)
+        {
+            auto it = m_tasks.find(key);
+            if (it == m_tasks.end())
+            {
+                continue;
+            }
+
+            requeue(std::move(it->second.second), toSync);
+            m_tasks.erase(it);
+            restored.push_back(std::move(key));
+        }
+
+        m_resolved.clear();
+        return restored;
+    }
+
+    /* Resolve the constraint in the retry caches of all consumers */
+    static void resolveAll(const Constraint &cst)
+    {
+        for (auto cache : instances())
+        {
+            cache->resolve(cst);
+        }
+    }
+
+    /* Retry caches that got tasks resolved since the last call */
+    static std::vector<RetryCache *> takeResolved()
+    {
+        std::vector<RetryCache *> caches;
+        caches.swap(resolvedCaches());
+        return caches;
+    }
+
+private:
+    /* Constraint, keys of the tasks waiting for it */
+    std::unordered_map<Constraint, std::unordered_set<std::string>, ConstraintHash> m_waiting;
+    /* Key, parked task and the constraint it is waiting for */
+    std::unordered_map<std::string, std::pair<Constraint, swss::KeyOpFieldsValuesTuple>> m_tasks;
+    /* Keys of the tasks to re-queue */
+    std::vector<std::string> m_resolved;
+
+    static std::unordered_set<RetryCache *>& instances()
+    {
+        static std::unordered_set<RetryCache *> caches;
+        return caches;
+    }
+
+    static std::vector<RetryCache *>& resolvedCaches()
+    {
+        static std::vector<RetryCache *> caches;
+        return caches;
+    }
+
+    void unwait(const Constraint &cst, const std::string &key)
+    {
+        auto waiting = m_waiting.find(cst);
+        if (waiting == m_waiting.end())
+        {
+            return;
+        }
+
+        waiting->second.erase(key);
+        if (waiting->second.empty())
+        {
+            m_waiting.erase(waiting);
+        }
+    }
+
+    /* The parked task is older than any pending task of the same key */
+    static void requeue(swss::KeyOpFieldsValuesTuple &&task, SyncMap &toSync)
+    {
+        auto it = toSync.find(kfvKey(task));
+        if (it == toSync.end())
+        {
+            toSync.merge(std::move(task));
+            return;
+        }
+
+        swss::KeyOpFieldsValuesTuple pending = std::move(it->second);
+        toSync.erase(it);
+        toSync.merge(std::move(task));
+        toSync.merge(std::move(pending));
+    }
+};
+
+#endif /* SWSS_RETRYCACHE_H */
@@ -3,6 +3,8 @@
 #include "logger.h"
 #include "swssnet.h"
 #include "crmorch.h"
+#include "timer.h"
+#include "subscriberstatetable.h"
 
 extern sai_object_id_t gVirtualRouterId;
 extern sai_object_id_t gSwitchId;
@@ -14,17 +16,53 @@ extern sai_switch_api_t*            sai_switch_api;
 extern PortsOrch *gPortsOrch;
 extern CrmOrch *gCrmOrch;
 
+extern size_t gMaxBulkSize;
+extern bool gNhgInPlaceUpdate;
+
+/* Number of synced routes checked by one resync sweep pass */
+#define RESYNC_SWEEP_BATCH_SIZE         1000
+/* Interval of the resync sweep passes */
+#define RESYNC_SWEEP_INTERVAL_NSECS     10000000
+
 /* Default maximum number of next hop groups */
 #define DEFAULT_NUMBER_OF_ECMP_GROUPS   128
 #define DEFAULT_MAX_ECMP_GROUP_SIZE     32
 
 const int routeorch_pri = 5;
 
-RouteOrch::RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch) :
+/* Routes on the management and host interfaces are not programmed to the ASIC */
+static bool isHostInterface(const string &alias)
+{
+    return alias == "eth0" || alias == "lo" || alias == "docker0";
+}
+
+/* Heap memory of a route key, none when it is stored inline */
+static size_t stringHeapBytes(const string &str)
+{
+    const char *object = reinterpret_cast<const char *>(&str);
+    if (str.data() >= object && str.data() < object + sizeof(str))
+    {
+        return 0;
+    }
+    return str.capacity() + 1;
+}
+
+RouteOrch::RouteOrch(DBConnector *db, string tableName, DBConnector *configDb, NeighOrch *neighOrch) :
         Orch(db, tableName, routeorch_pri),
         m_neighOrch(neighOrch),
         m_nextHopGroupCount(0),
-        m_resync(false)
+        m_resync(false),
+        m_resyncEpoch(0),
+        m_resyncSweeping(false),
+        m_resyncCursor("0.0.0.0/0"),
+        m_resyncRefreshed(0),
+        m_resyncSwept(0),
+        m_resyncRemoved(0),
+        m_duplicateRoutes(0),
+        m_fastDuplicateRoutes(0),
+        m_routeClassStats(1, RoutePriorityStats()),
+        m_routeBulker(sai_route_api, gMaxBulkSize),
+        m_nextHopGroupMemberBulker(sai_next_hop_group_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 
@@ -80,7 +118,7 @@ RouteOrch::RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch) :
     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
 
     /* Add default IPv4 route into the m_syncdRoutes */
-    m_syncdRoutes[default_ip_prefix] = IpAddresses();
+    setSyncdRoute(default_ip_prefix, IpAddresses());
 
     SWSS_LOG_NOTICE("Create IPv4 default route with packet action drop");
 
@@ -99,9 +137,18 @@ RouteOrch::RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch) :
     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
 
     /* Add default IPv6 route into the m_syncdRoutes */
-    m_syncdRoutes[v6_default_ip_prefix] = IpAddresses();
+    setSyncdRoute(v6_default_ip_prefix, IpAddresses());
 
     SWSS_LOG_NOTICE("Create IPv6 default route with packet action drop");
+
+    /* The resync sweep runs only after a resync completes */
+    m_resyncTimer = new SelectableTimer(timespec { .tv_sec = 0, .tv_nsec = RESYNC_SWEEP_INTERVAL_NSECS });
+    Orch::addExecutor("ROUTE_RESYNC_SWEEP", new ExecutableTimer(m_resyncTimer, this));
+
+    /* Route priority classes are configured before the routes are served */
+    Consumer *priorityConsumer = new Consumer(new SubscriberStateTable(configDb, CFG_ROUTE_PRIORITY_TABLE_NAME,
+                TableConsumable::DEFAULT_POP_BATCH_SIZE, routeorch_pri + 1), this);
+    Orch::addExecutor(CFG_ROUTE_PRIORITY_TABLE_NAME, priorityConsumer);
 }
 
 bool RouteOrch::hasNextHopGroup(const IpAddresses& ipAddresses) const
@@ -125,16 +172,13 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr)
 
     if (observerEntry == m_nextHopObservers.end())
     {
-        m_nextHopObservers.emplace(dstAddr, NextHopObserverEntry());
-        observerEntry = m_nextHopObservers.find(dstAddr);
+        observerEntry = m_nextHopObservers.emplace(dstAddr, NextHopObserverEntry()).first;
+        m_nextHopObserverIndex.insert(dstAddr, observerEntry);
 
-        for (auto route : m_syncdRoutes)
+        m_routeIndex.visitCovering(dstAddr, [&](SyncdRouteTable::iterator &route)
         {
-            if (route.first.isAddressInSubnet(dstAddr))
-            {
-                observerEntry->second.routeTable.emplace(route.first, route.second);
-            }
-        }
+            observerEntry->second.routeTable.emplace(route->first, route->second.nexthops);
+        });
     }
 
     observerEntry->second.observers.push_back(observer);
@@ -142,7 +186,7 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr)
     auto route = observerEntry->second.routeTable.rbegin();
     if (route != observerEntry->second.routeTable.rend())
     {
-        NextHopUpdate update = { route->first, route->second };
+        NextHopUpdate update = { route->first, *route->second };
         observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
     }
 }
@@ -168,135 +212,189 @@ void RouteOrch::detach(Observer *observer, const IpAddress& dstAddr)
     }
 }
 
-bool RouteOrch::validnexthopinNextHopGroup(const IpAddress &ipaddr)
+/*
+ * Add back the members of the next hops whose interfaces came up. Only the
+ * groups containing the next hops are visited, using the next hop group
+ * index, and their members are created in one bulk call.
+ */
+bool RouteOrch::validnexthopsinNextHopGroups(const vector<IpAddress> &ipaddrs)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
+    vector<pair<NextHopGroupEntry *, IpAddress>> nhgms;
 
-    for (auto nhopgroup = m_syncdNextHopGroups.begin();
-         nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
+    for (const auto &ipaddr : ipaddrs)
     {
-
-        if (!(nhopgroup->first.contains(ipaddr)))
+        auto groups = m_nextHopGroupIndex.find(ipaddr);
+        if (groups == m_nextHopGroupIndex.end())
         {
             continue;
         }
 
+        for (auto nhopgroup : groups->second)
+        {
+            nhgms.emplace_back(nhopgroup, ipaddr);
+        }
+    }
+
+    vector<sai_object_id_t> nhgm_ids(nhgms.size());
+    vector<sai_status_t> nhgm_statuses(nhgms.size());
+
+    for (size_t i = 0; i < nhgms.size(); i++)
+    {
         vector<sai_attribute_t> nhgm_attrs;
         sai_attribute_t nhgm_attr;
 
         nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-        nhgm_attr.value.oid = nhopgroup->second.next_hop_group_id;
+        nhgm_attr.value.oid = nhgms[i].first->next_hop_group_id;
         nhgm_attrs.push_back(nhgm_attr);
 
         nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = m_neighOrch->getNextHopId(ipaddr);
+        nhgm_attr.value.oid = m_neighOrch->getNextHopId(nhgms[i].second);
         nhgm_attrs.push_back(nhgm_attr);
 
-        status = sai_next_hop_group_api->create_next_hop_group_member(&nexthop_id, gSwitchId,
-                                                                      (uint32_t)nhgm_attrs.size(),
-                                                                      nhgm_attrs.data());
+        m_nextHopGroupMemberBulker.create_entry(&nhgm_statuses[i], &nhgm_ids[i],
+                                                (uint32_t)nhgm_attrs.size(), nhgm_attrs.data());
+    }
+
+    m_nextHopGroupMemberBulker.flush();
 
-        if (status != SAI_STATUS_SUCCESS)
+    bool success = true;
+    for (size_t i = 0; i < nhgms.size(); i++)
+    {
+        if (nhgm_statuses[i] != SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("Failed to add next hop member to group %lx: %d\n",
-                           nhopgroup->second.next_hop_group_id, status);
-            return false;
+            SWSS_LOG_ERROR("Failed to add next hop member %s to group %lx: %d\n",
+                           nhgms[i].second.to_string().c_str(),
+                           nhgms[i].first->next_hop_group_id, nhgm_statuses[i]);
+            success = false;
+            continue;
         }
 
         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
-        nhopgroup->second.nhopgroup_members[ipaddr] = nexthop_id;
+        nhgms[i].first->nhopgroup_members[nhgms[i].second] = nhgm_ids[i];
     }
 
-    return true;
+    return success;
 }
 
-bool RouteOrch::invalidnexthopinNextHopGroup(const IpAddress &ipaddr)
+/*
+ * Remove the members of the next hops whose interfaces went down from the
+ * groups containing them in one bulk call.
+ */
+bool RouteOrch::invalidnexthopsinNextHopGroups(const vector<IpAddress> &ipaddrs)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
+    vector<pair<NextHopGroupEntry *, NextHopGroupMembers::iterator>> nhgms;
 
-    for (auto nhopgroup = m_syncdNextHopGroups.begin();
-         nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
+    for (const auto &ipaddr : ipaddrs)
     {
-
-        if (!(nhopgroup->first.contains(ipaddr)))
+        auto groups = m_nextHopGroupIndex.find(ipaddr);
+        if (groups == m_nextHopGroupIndex.end())
         {
             continue;
         }
 
-        nexthop_id = nhopgroup->second.nhopgroup_members[ipaddr];
-        status = sai_next_hop_group_api->remove_next_hop_group_member(nexthop_id);
+        for (auto nhopgroup : groups->second)
+        {
+            auto member = nhopgroup->nhopgroup_members.find(ipaddr);
+            if (member == nhopgroup->nhopgroup_members.end() || member->second == SAI_NULL_OBJECT_ID)
+            {
+                continue;
+            }
 
-        if (status != SAI_STATUS_SUCCESS)
+            nhgms.emplace_back(nhopgroup, member);
+        }
+    }
+
+    vector<sai_status_t> nhgm_statuses(nhgms.size());
+
+    for (size_t i = 0; i < nhgms.size(); i++)
+    {
+        m_nextHopGroupMemberBulker.remove_entry(&nhgm_statuses[i], nhgms[i].second->second);
+    }
+
+    m_nextHopGroupMemberBulker.flush();
+
+    bool success = true;
+    for (size_t i = 0; i < nhgms.size(); i++)
+    {
+        if (nhgm_statuses[i] != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to remove next hop member %lx from group %lx: %d\n",
-                           nexthop_id, nhopgroup->second.next_hop_group_id, status);
-            return false;
+                           nhgms[i].second->second, nhgms[i].first->next_hop_group_id,
+                           nhgm_statuses[i]);
+            success = false;
+            continue;
         }
 
         gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+        nhgms[i].second->second = SAI_NULL_OBJECT_ID;
     }
 
-    return true;
+    return success;
 }
 
 void RouteOrch::doTask(Consumer& consumer)
 {
     SWSS_LOG_ENTER();
 
+    if (consumer.getTableName() == CFG_ROUTE_PRIORITY_TABLE_NAME)
+    {
+        doRoutePriorityTask(consumer);
+        return;
+    }
+
     if (!gPortsOrch->isInitDone())
     {
         return;
     }
 
+    /* Queue the routes of the higher priority classes first */
+    prioritizeRoutes(consumer.m_toSync);
+
+    /* Route operations queued to the bulker in this pass, with the contexts
+     * used to reconcile their statuses once the bulker is flushed */
+    std::deque<std::pair<SyncMap::iterator, RouteBulkContext>> toAdd;
+    std::deque<std::pair<SyncMap::iterator, RouteBulkContext>> toRemove;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        const KeyOpFieldsValuesTuple &t = it->second;
 
         string key = kfvKey(t);
         string op = kfvOp(t);
 
         /* Get notification from application */
         /* resync application:
-         * When routeorch receives 'resync' message, it marks all current
-         * routes as dirty and waits for 'resync complete' message. For all
-         * newly received routes, if they match current dirty routes, it unmarks
-         * them dirty. After receiving 'resync complete' message, it creates all
-         * newly added routes and removes all dirty routes.
+         * When routeorch receives 'resync' message, it starts a new route
+         * generation, which marks all current routes as dirty. Routes received
+         * during the resync are processed as usual, and the routes announced
+         * again are stamped with the new generation. After receiving 'resync
+         * complete' message, the routes of older generations are removed in
+         * batches.
          */
         if (key == "resync")
         {
             if (op == "SET")
             {
-                /* Mark all current routes as dirty (DEL) in consumer.m_toSync map */
-                SWSS_LOG_NOTICE("Start resync routes\n");
-                for (auto i : m_syncdRoutes)
-                {
-                    vector<FieldValueTuple> v;
-                    auto x = KeyOpFieldsValuesTuple(i.first.to_string(), DEL_COMMAND, v);
-                    consumer.m_toSync[i.first.to_string()] = x;
-                }
-                m_resync = true;
+                startResync();
             }
             else
             {
-                SWSS_LOG_NOTICE("Complete resync routes\n");
-                m_resync = false;
+                completeResync();
             }
 
-            it = consumer.m_toSync.erase(it);
+            it = eraseRouteTask(consumer, it);
             continue;
         }
 
-        if (m_resync)
+        /* Drop the routes announced again with the same next hops before parsing them */
+        if (op == SET_COMMAND && isDuplicateRoute(key, t))
         {
-            it++;
+            it = eraseRouteTask(consumer, it);
             continue;
         }
 
@@ -305,12 +403,16 @@ void RouteOrch::doTask(Consumer& consumer)
         if (op == SET_COMMAND)
         {
             IpAddresses ip_addresses;
+            string nexthops;
             string alias;
 
             for (auto i : kfvFieldsValues(t))
             {
                 if (fvField(i) == "nexthop")
-                    ip_addresses = IpAddresses(fvValue(i));
+                {
+                    nexthops = fvValue(i);
+                    ip_addresses = IpAddresses(nexthops);
+                }
 
                 if (fvField(i) == "ifname")
                     alias = fvValue(i);
@@ -319,282 +421,993 @@ void RouteOrch::doTask(Consumer& consumer)
             // TODO: set to blackhold if nexthop is empty?
             if (ip_addresses.getSize() == 0)
             {
-                it = consumer.m_toSync.erase(it);
+                it = eraseRouteTask(consumer, it);
                 continue;
             }
 
             // TODO: cannot trust m_portsOrch->getPortIdByAlias because sometimes alias is empty
             // TODO: need to split aliases with ',' and verify the next hops?
-            if (alias == "eth0" || alias == "lo" || alias == "docker0")
+            if (isHostInterface(alias))
             {
                 /* If any existing routes are updated to point to the
                  * above interfaces, remove them from the ASIC. */
                 if (m_syncdRoutes.find(ip_prefix) != m_syncdRoutes.end())
                 {
-                    if (removeRoute(ip_prefix))
-                        it = consumer.m_toSync.erase(it);
-                    else
-                        it++;
+                    toRemove.emplace_back(it, RouteBulkContext(ip_prefix));
+                    removeRoute(toRemove.back().second);
+                    it++;
                 }
                 else
-                    it = consumer.m_toSync.erase(it);
+                    it = eraseRouteTask(consumer, it);
                 continue;
             }
 
-            if (m_syncdRoutes.find(ip_prefix) == m_syncdRoutes.end() || m_syncdRoutes[ip_prefix] != ip_addresses)
+            auto it_route = m_syncdRoutes.find(ip_prefix);
+            if (it_route == m_syncdRoutes.end() || it_route->second.nexthops != ip_addresses)
             {
-                if (addRoute(ip_prefix, ip_addresses))
-                    it = consumer.m_toSync.erase(it);
-                else
-                    it++;
+                toAdd.emplace_back(it, RouteBulkContext(ip_prefix));
+                toAdd.back().second.key = key;
+                if (!addRoute(toAdd.back().second, ip_addresses))
+                {
+                    toAdd.pop_back();
+
+                    /* Nothing is queued. Wait for the missing next hop if
+                     * any, otherwise retry it in the next pass */
+                    IpAddress missing_nh;
+                    if (getMissingNextHop(ip_addresses, missing_nh))
+                    {
+                        it = parkRouteTask(consumer, it, Constraint(RETRY_CST_NEXTHOP, missing_nh.to_string()));
+                        continue;
+                    }
+                }
+                it++;
             }
             else
-                /* Duplicate entry */
-                it = consumer.m_toSync.erase(it);
+            {
+                /* Duplicate entry with the next hops in another order or key
+                 * format, keep the key so that the next one may be found unparsed */
+                refreshRoute(it_route->second);
+                setSyncdRouteKey(it_route, key);
+                it = eraseRouteTask(consumer, it);
+            }
         }
         else if (op == DEL_COMMAND)
         {
             if (m_syncdRoutes.find(ip_prefix) != m_syncdRoutes.end())
             {
-                if (removeRoute(ip_prefix))
-                    it = consumer.m_toSync.erase(it);
-                else
-                    it++;
+                toRemove.emplace_back(it, RouteBulkContext(ip_prefix));
+                removeRoute(toRemove.back().second);
+                it++;
             }
             else
                 /* Cannot locate the route */
-                it = consumer.m_toSync.erase(it);
+                it = eraseRouteTask(consumer, it);
         }
         else
         {
             SWSS_LOG_ERROR("Unknown operation type %s\n", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            it = eraseRouteTask(consumer, it);
         }
     }
-}
 
-void RouteOrch::notifyNextHopChangeObservers(IpPrefix prefix, IpAddresses nexthops, bool add)
-{
-    SWSS_LOG_ENTER();
+    if (m_routeBulker.empty())
+    {
+        return;
+    }
 
-    for (auto& entry : m_nextHopObservers)
+    /* Submit all queued route operations, then reconcile each per-entry
+     * status with m_syncdRoutes, the next hop ref counts and CRM counters.
+     * Entries whose operation failed stay in m_toSync for retry. */
+    m_routeBulker.flush();
+
+    for (auto& entry : toRemove)
     {
-        if (!prefix.isAddressInSubnet(entry.first))
+        if (removeRoutePost(entry.second))
         {
-            continue;
+            eraseRouteTask(consumer, entry.first);
         }
+    }
 
-        if (add)
-        {
-            bool update_required = false;
-            NextHopUpdate update = { prefix, nexthops };
-
-            /* Table should not be empty. Default route should always exists. */
-            assert(!entry.second.routeTable.empty());
-
-            auto route = entry.second.routeTable.find(prefix);
-            if (route == entry.second.routeTable.end())
-            {
-                /* If added route is best match update observers */
-                if (entry.second.routeTable.rbegin()->first < prefix)
-                {
-                    update_required = true;
-                }
-
-                entry.second.routeTable.emplace(prefix, nexthops);
-            }
-            else
-            {
-                if (route->second != nexthops)
-                {
-                    route->second = nexthops;
-                    /* If changed route is best match update observers */
-                    if (entry.second.routeTable.rbegin()->first == route->first)
-                    {
-                        update_required = true;
-                    }
-                }
-            }
+    for (auto& entry : toAdd)
+    {
+        auto& ctx = entry.second;
+        IpAddress missing_nh;
 
-            if (update_required)
-            {
-                for (auto observer : entry.second.observers)
-                {
-                    observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
-                }
-            }
+        if (addRoutePost(ctx))
+        {
+            eraseRouteTask(consumer, entry.first);
         }
-        else
+        else if (ctx.using_temp_nhg && getMissingNextHop(ctx.requested_nhg, missing_nh))
         {
-            auto route = entry.second.routeTable.find(prefix);
-            if (route != entry.second.routeTable.end())
-            {
-                /* If removed route was best match find another best match route */
-                if (route->first == entry.second.routeTable.rbegin()->first)
-                {
-                    entry.second.routeTable.erase(route);
-
-                    /* Table should not be empty. Default route should always exists. */
-                    assert(!entry.second.routeTable.empty());
-
-                    auto route = entry.second.routeTable.rbegin();
-                    NextHopUpdate update = { route->first, route->second };
-
-                    for (auto observer : entry.second.observers)
-                    {
-                        observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
-                    }
-                }
-                else
-                {
-                    entry.second.routeTable.erase(route);
-                }
-            }
+            /* Keep the temporary route until the missing next hop is added */
+            parkRouteTask(consumer, entry.first, Constraint(RETRY_CST_NEXTHOP, missing_nh.to_string()));
         }
     }
 }
 
-void RouteOrch::increaseNextHopRefCount(IpAddresses ipAddresses)
+/*
+ * Track the route tasks queued to be classified in the next pass. A task
+ * merged with a newer update is classified again, as the update may change
+ * its class, and keeps the time it was first queued.
+ */
+void RouteOrch::onTaskQueued(Consumer &consumer, const string &key)
 {
-    /* Return when there is no next hop (dropped) */
-    if (ipAddresses.getSize() == 0)
+    if (m_routeClasses.empty() || key == "resync" || consumer.getTableName() != APP_ROUTE_TABLE_NAME)
     {
         return;
     }
-    else if (ipAddresses.getSize() == 1)
-    {
-        IpAddress ip_address(ipAddresses.to_string());
-        m_neighOrch->increaseNextHopRefCount(ip_address);
-    }
-    else
-    {
-        m_syncdNextHopGroups[ipAddresses].ref_count ++;
-    }
-}
-void RouteOrch::decreaseNextHopRefCount(IpAddresses ipAddresses)
-{
-    /* Return when there is no next hop (dropped) */
-    if (ipAddresses.getSize() == 0)
+
+    auto pending = m_pendingRouteTasks.find(key);
+    if (pending == m_pendingRouteTasks.end())
     {
-        return;
+        PendingRouteTask task = { m_routeClasses.size(), chrono::steady_clock::now(), false };
+        pending = m_pendingRouteTasks.emplace(key, task).first;
     }
-    else if (ipAddresses.getSize() == 1)
-    {
-        IpAddress ip_address(ipAddresses.to_string());
 
-        m_neighOrch->decreaseNextHopRefCount(ip_address);
-    }
-    else
+    if (!pending->second.queued)
     {
-        m_syncdNextHopGroups[ipAddresses].ref_count --;
+        pending->second.queued = true;
+        m_queuedRouteTasks.push_back(key);
     }
 }
 
-bool RouteOrch::isRefCounterZero(const IpAddresses& ipAddresses) const
+/* Return the class of the pending route task, the number of classes if none */
+size_t RouteOrch::getPendingRouteClass(const string &key) const
 {
-    if (!hasNextHopGroup(ipAddresses))
+    auto pending = m_pendingRouteTasks.find(key);
+    if (pending == m_pendingRouteTasks.end())
     {
-        return true;
+        return m_routeClasses.size();
     }
 
-    return m_syncdNextHopGroups.at(ipAddresses).ref_count == 0;
+    return pending->second.route_class;
 }
 
-bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
+/*
+ * Move the route tasks of the priority classes to the front of the tasks, in
+ * the order of the classes, so that they are queued to the bulker first. Only
+ * the tasks queued since the last pass are classified and moved, after the
+ * tasks of the same or higher priority classes left at the front. The tasks
+ * are not moved across a resync message, which delimits the routes of a
+ * resync generation, so all the tasks are ordered again while one is pending.
+ */
+void RouteOrch::prioritizeRoutes(SyncMap &toSync)
 {
-    SWSS_LOG_ENTER();
-
-    assert(!hasNextHopGroup(ipAddresses));
-
-    if (m_nextHopGroupCount >= m_maxNextHopGroupCount)
+    if (m_queuedRouteTasks.empty())
     {
-        SWSS_LOG_DEBUG("Failed to create new next hop group. \
-                        Reaching maximum number of next hop groups.");
-        return false;
+        return;
     }
 
-    vector<sai_object_id_t> next_hop_ids;
-    set<IpAddress> next_hop_set = ipAddresses.getIpAddresses();
-    sai_object_id_t next_hop_id;
-    std::map<sai_object_id_t, IpAddress> nhopgroup_members_set;
+    vector<vector<SyncMap::iterator>> classes(m_routeClasses.size());
+    bool resync = toSync.count("resync") != 0;
 
-    /* Assert each IP address exists in m_syncdNextHops table,
-     * and add the corresponding next_hop_id to next_hop_ids. */
-    for (auto it : next_hop_set)
+    for (const auto &key : m_queuedRouteTasks)
     {
-        if (!m_neighOrch->hasNextHop(it))
+        auto pending = m_pendingRouteTasks.find(key);
+        if (pending == m_pendingRouteTasks.end() || !pending->second.queued)
         {
-            SWSS_LOG_INFO("Failed to get next hop %s in %s",
-                    it.to_string().c_str(), ipAddresses.to_string().c_str());
-            return false;
+            continue;
         }
 
-        sai_object_id_t next_hop_id = m_neighOrch->getNextHopId(it);
-        next_hop_ids.push_back(next_hop_id);
-        nhopgroup_members_set[next_hop_id] = it;
-    }
-
-    sai_attribute_t nhg_attr;
-    vector<sai_attribute_t> nhg_attrs;
-
-    nhg_attr.id = SAI_NEXT_HOP_GROUP_ATTR_TYPE;
-    nhg_attr.value.s32 = SAI_NEXT_HOP_GROUP_TYPE_ECMP;
-    nhg_attrs.push_back(nhg_attr);
+        pending->second.queued = false;
 
-    sai_object_id_t next_hop_group_id;
-    sai_status_t status = sai_next_hop_group_api->create_next_hop_group(&next_hop_group_id,
-                                                                        gSwitchId,
-                                                                        (uint32_t)nhg_attrs.size(),
-                                                                        nhg_attrs.data());
+        auto it = toSync.find(key);
+        if (it == toSync.end())
+        {
+            continue;
+        }
 
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to create next hop group %s, rv:%d",
-                       ipAddresses.to_string().c_str(), status);
-        return false;
+        pending->second.route_class = getRouteClass(key, it->second);
+        if (!resync && pending->second.route_class < classes.size())
+        {
+            classes[pending->second.route_class].push_back(it);
+        }
     }
 
-    m_nextHopGroupCount ++;
-    SWSS_LOG_NOTICE("Create next hop group %s", ipAddresses.to_string().c_str());
-
-    gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
-
-    NextHopGroupEntry next_hop_group_entry;
-    next_hop_group_entry.next_hop_group_id = next_hop_group_id;
+    m_queuedRouteTasks.clear();
 
-    for (auto nhid: next_hop_ids)
+    if (resync)
     {
-        // Create a next hop group member
-        vector<sai_attribute_t> nhgm_attrs;
-
-        sai_attribute_t nhgm_attr;
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-        nhgm_attr.value.oid = next_hop_group_id;
-        nhgm_attrs.push_back(nhgm_attr);
-
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = nhid;
-        nhgm_attrs.push_back(nhgm_attr);
+        auto front = toSync.begin();
 
-        sai_object_id_t next_hop_group_member_id;
-        status = sai_next_hop_group_api->create_next_hop_group_member(&next_hop_group_member_id,
-                                                                      gSwitchId,
-                                                                      (uint32_t)nhgm_attrs.size(),
-                                                                      nhgm_attrs.data());
+        auto moveClasses = [&]()
+        {
+            for (auto &tasks : classes)
+            {
+                for (auto task : tasks)
+                {
+                    if (task == front)
+                    {
+                        front++;
+                    }
+                    else
+                    {
+                        toSync.move(front, task);
+                    }
+                }
+                tasks.clear();
+            }
+        };
 
-        if (status != SAI_STATUS_SUCCESS)
+        for (auto it = toSync.begin(); it != toSync.end(); it++)
         {
-            // TODO: do we need to clean up?
-            SWSS_LOG_ERROR("Failed to create next hop group %lx member %lx: %d\n",
-                           next_hop_group_id, next_hop_group_member_id, status);
-            return false;
+            if (it->first == "resync")
+            {
+                moveClasses();
+                front = next(it);
+                continue;
+            }
+
+            size_t route_class = getPendingRouteClass(it->first);
+            if (route_class < classes.size())
+            {
+                classes[route_class].push_back(it);
+            }
+        }
+
+        moveClasses();
+        return;
+    }
+
+    auto front = toSync.begin();
+    for (size_t i = 0; i < classes.size(); i++)
+    {
+        while (front != toSync.end() && getPendingRouteClass(front->first) <= i)
+        {
+            front++;
+        }
+
+        for (auto task : classes[i])
+        {
+            if (task == front)
+            {
+                front++;
+            }
+            else
+            {
+                toSync.move(front, task);
+            }
+        }
+    }
+}
+
+/* Return the index of the class of the route, the number of classes if none */
+size_t RouteOrch::getRouteClass(const string &key, const KeyOpFieldsValuesTuple &t) const
+{
+    IpPrefix prefix(key);
+
+    for (size_t i = 0; i < m_routeClasses.size(); i++)
+    {
+        const auto &route_class = m_routeClasses[i];
+
+        if (!route_class.prefix_lengths.empty() &&
+            route_class.prefix_lengths.find(prefix.getMaskLength()) == route_class.prefix_lengths.end())
+        {
+            continue;
+        }
+
+        if (!route_class.prefixes.empty())
+        {
+            bool covered = false;
+            for (const auto &covering : route_class.prefixes)
+            {
+                if (covering.getMaskLength() <= prefix.getMaskLength() &&
+                    covering.isAddressInSubnet(prefix.getIp()))
+                {
+                    covered = true;
+                    break;
+                }
+            }
+
+            if (!covered)
+            {
+                continue;
+            }
+        }
+
+        if (!route_class.field.empty())
+        {
+            bool matched = false;
+            for (const auto &i : kfvFieldsValues(t))
+            {
+                if (fvField(i) == route_class.field)
+                {
+                    matched = route_class.values.find(fvValue(i)) != route_class.values.end();
+                    break;
+                }
+            }
+
+            if (!matched)
+            {
+                continue;
+            }
+        }
+
+        return i;
+    }
+
+    return m_routeClasses.size();
+}
+
+/* Erase the route task once it is done, and account its latency to its class */
+SyncMap::iterator RouteOrch::eraseRouteTask(Consumer &consumer, SyncMap::iterator it)
+{
+    auto pending = m_pendingRouteTasks.find(it->first);
+    if (pending != m_pendingRouteTasks.end())
+    {
+        uint64_t latency = (uint64_t)chrono::duration_cast<chrono::microseconds>(
+                chrono::steady_clock::now() - pending->second.since).count();
+
+        auto &stats = m_routeClassStats[pending->second.route_class];
+        stats.routes++;
+        stats.total_latency_us += latency;
+        stats.max_latency_us = max(stats.max_latency_us, latency);
+
+        m_pendingRouteTasks.erase(pending);
+    }
+
+    return consumer.m_toSync.erase(it);
+}
+
+/* Park the route task, its latency is accounted again once it is restored */
+SyncMap::iterator RouteOrch::parkRouteTask(Consumer &consumer, SyncMap::iterator it, const Constraint &cst)
+{
+    m_pendingRouteTasks.erase(it->first);
+
+    return consumer.addToRetry(it, cst);
+}
+
+/*
+ * Configure the route priority classes:
+ *   ROUTE_PRIORITY|<name>
+ *     "priority": lower values are programmed first
+ *     "prefix_length": list of prefix lengths or ranges, e.g. "0,32,120-128"
+ *     "prefixes": list of prefixes covering the routes
+ *     "field", "values": field of the route entry and the list of its values
+ */
+void RouteOrch::doRoutePriorityTask(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = consumer.m_toSync.begin();
+    while (it != consumer.m_toSync.end())
+    {
+        KeyOpFieldsValuesTuple t = it->second;
+
+        string key = kfvKey(t);
+        string op = kfvOp(t);
+
+        if (op == SET_COMMAND)
+        {
+            RoutePriorityClass route_class;
+            route_class.name = key;
+            route_class.priority = 0;
+
+            try
+            {
+                for (auto i : kfvFieldsValues(t))
+                {
+                    if (fvField(i) == "priority")
+                    {
+                        route_class.priority = stoi(fvValue(i));
+                    }
+                    else if (fvField(i) == "prefix_length")
+                    {
+                        for (auto &range : tokenize(fvValue(i), list_item_delimiter))
+                        {
+                            sai_uint32_t low, high;
+                            if (!parseIndexRange(range, low, high))
+                            {
+                                throw invalid_argument(range);
+                            }
+                            for (sai_uint32_t len = low; len <= high; len++)
+                            {
+                                route_class.prefix_lengths.insert((int)len);
+                            }
+                        }
+                    }
+                    else if (fvField(i) == "prefixes")
+                    {
+                        for (auto &prefix : tokenize(fvValue(i), list_item_delimiter))
+                        {
+                            route_class.prefixes.emplace_back(prefix);
+                        }
+                    }
+                    else if (fvField(i) == "field")
+                    {
+                        route_class.field = fvValue(i);
+                    }
+                    else if (fvField(i) == "values")
+                    {
+                        for (auto &value : tokenize(fvValue(i), list_item_delimiter))
+                        {
+                            route_class.values.insert(value);
+                        }
+                    }
+                    else
+                    {
+                        SWSS_LOG_WARN("Unknown route priority class %s field %s",
+                                      key.c_str(), fvField(i).c_str());
+                    }
+                }
+            }
+            catch (const exception &e)
+            {
+                SWSS_LOG_ERROR("Failed to parse route priority class %s: %s", key.c_str(), e.what());
+                it = consumer.m_toSync.erase(it);
+                continue;
+            }
+
+            SWSS_LOG_NOTICE("Set route priority class %s priority %d", key.c_str(), route_class.priority);
+            m_routeClassConfig[key] = route_class;
+        }
+        else if (op == DEL_COMMAND)
+        {
+            SWSS_LOG_NOTICE("Remove route priority class %s", key.c_str());
+            m_routeClassConfig.erase(key);
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Unknown operation type %s\n", op.c_str());
+        }
+
+        it = consumer.m_toSync.erase(it);
+    }
+
+    /* Order the classes by priority, and classify the pending routes again */
+    m_routeClasses.clear();
+    for (const auto &route_class : m_routeClassConfig)
+    {
+        m_routeClasses.push_back(route_class.second);
+    }
+
+    stable_sort(m_routeClasses.begin(), m_routeClasses.end(),
+                [](const RoutePriorityClass &a, const RoutePriorityClass &b) { return a.priority < b.priority; });
+
+    m_routeClassStats.assign(m_routeClasses.size() + 1, RoutePriorityStats());
+    m_pendingRouteTasks.clear();
+    m_queuedRouteTasks.clear();
+
+    auto *routeConsumer = dynamic_cast<Consumer *>(getExecutor(APP_ROUTE_TABLE_NAME));
+    assert(routeConsumer);
+
+    for (const auto &task : routeConsumer->m_toSync)
+    {
+        onTaskQueued(*routeConsumer, task.first);
+    }
+}
+
+void RouteOrch::startResync()
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("Start resync routes\n");
+
+    /* The routes of older generations are dirty until announced again */
+    m_resyncEpoch++;
+    m_resync = true;
+    m_resyncRefreshed = 0;
+    m_resyncSwept = 0;
+    m_resyncRemoved = 0;
+
+    if (m_resyncSweeping)
+    {
+        m_resyncSweeping = false;
+        m_resyncTimer->stop();
+    }
+}
+
+void RouteOrch::completeResync()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_resync)
+    {
+        return;
+    }
+
+    SWSS_LOG_NOTICE("Complete resync routes, %zu routes refreshed\n", m_resyncRefreshed);
+
+    m_resync = false;
+    m_resyncSweeping = true;
+    m_resyncCursor = m_syncdRoutes.begin()->first;
+    m_resyncTimer->start();
+}
+
+/*
+ * Remove a batch of the routes that were not announced again during the
+ * resync, by queuing DEL tasks for them. Routes with a pending task are left
+ * to the task.
+ */
+void RouteOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_resyncSweeping)
+    {
+        timer.stop();
+        return;
+    }
+
+    auto *consumer = dynamic_cast<Consumer *>(getExecutor(APP_ROUTE_TABLE_NAME));
+    assert(consumer);
+
+    auto it_route = m_syncdRoutes.lower_bound(m_resyncCursor);
+    for (size_t i = 0; i < RESYNC_SWEEP_BATCH_SIZE && it_route != m_syncdRoutes.end(); i++, it_route++)
+    {
+        m_resyncSwept++;
+
+        if (it_route->second.epoch == m_resyncEpoch)
+        {
+            continue;
+        }
+
+        /* The route has a pending or parked update since the resync started */
+        string key = it_route->first.to_string();
+        if (consumer->m_toSync.count(key) || consumer->m_toRetry.contains(key))
+        {
+            continue;
+        }
+
+        consumer->addToSync(KeyOpFieldsValuesTuple(key, DEL_COMMAND, vector<FieldValueTuple>()));
+        m_resyncRemoved++;
+    }
+
+    if (it_route == m_syncdRoutes.end())
+    {
+        SWSS_LOG_NOTICE("Resync routes swept, %zu stale routes removed\n", m_resyncRemoved);
+        m_resyncSweeping = false;
+        timer.stop();
+    }
+    else
+    {
+        m_resyncCursor = it_route->first;
+    }
+
+    consumer->drain();
+}
+
+/* Get a next hop of the set that is not synced yet */
+bool RouteOrch::getMissingNextHop(const IpAddresses &nextHops, IpAddress &missing) const
+{
+    for (const auto &nh : nextHops.getIpAddresses())
+    {
+        if (!m_neighOrch->hasNextHop(nh))
+        {
+            missing = nh;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void RouteOrch::notifyNextHopChangeObservers(IpPrefix prefix, IpAddresses nexthops, bool add)
+{
+    SWSS_LOG_ENTER();
+
+    vector<NextHopObserverTable::iterator> entries;
+    m_nextHopObserverIndex.visitCovered(prefix, [&](NextHopObserverTable::iterator &entry)
+    {
+        entries.push_back(entry);
+    });
+
+    for (auto it : entries)
+    {
+        auto& entry = *it;
+
+        if (add)
+        {
+            bool update_required = false;
+            NextHopUpdate update = { prefix, nexthops };
+
+            /* Table should not be empty. Default route should always exists. */
+            assert(!entry.second.routeTable.empty());
+
+            auto route = entry.second.routeTable.find(prefix);
+            if (route == entry.second.routeTable.end())
+            {
+                /* If added route is best match update observers */
+                if (entry.second.routeTable.rbegin()->first < prefix)
+                {
+                    update_required = true;
+                }
+
+                entry.second.routeTable.emplace(prefix, nexthops);
+            }
+            else
+            {
+                if (route->second != nexthops)
+                {
+                    route->second = nexthops;
+                    /* If changed route is best match update observers */
+                    if (entry.second.routeTable.rbegin()->first == route->first)
+                    {
+                        update_required = true;
+                    }
+                }
+            }
+
+            if (update_required)
+            {
+                for (auto observer : entry.second.observers)
+                {
+                    observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
+                }
+            }
+        }
+        else
+        {
+            auto route = entry.second.routeTable.find(prefix);
+            if (route != entry.second.routeTable.end())
+            {
+                /* If removed route was best match find another best match route */
+                if (route->first == entry.second.routeTable.rbegin()->first)
+                {
+                    entry.second.routeTable.erase(route);
+
+                    /* Table should not be empty. Default route should always exists. */
+                    assert(!entry.second.routeTable.empty());
+
+                    auto route = entry.second.routeTable.rbegin();
+                    NextHopUpdate update = { route->first, *route->second };
+
+                    for (auto observer : entry.second.observers)
+                    {
+                        observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
+                    }
+                }
+                else
+                {
+                    entry.second.routeTable.erase(route);
+                }
+            }
+        }
+    }
+}
+
+void RouteOrch::setSyncdRoute(const IpPrefix &ipPrefix, const IpAddresses &nextHops)
+{
+    auto it_route = m_syncdRoutes.find(ipPrefix);
+    if (it_route != m_syncdRoutes.end())
+    {
+        it_route->second.nexthops = nextHops;
+        it_route->second.epoch = m_resyncEpoch;
+        return;
+    }
+
+    it_route = m_syncdRoutes.emplace(ipPrefix, SyncdRoute{ nextHops, m_resyncEpoch, false }).first;
+    m_routeIndex.insert(ipPrefix, it_route);
+}
+
+void RouteOrch::eraseSyncdRoute(const IpPrefix &ipPrefix)
+{
+    auto it_route = m_syncdRoutes.find(ipPrefix);
+    if (it_route == m_syncdRoutes.end())
+    {
+        return;
+    }
+
+    eraseSyncdRouteKey(it_route);
+    m_syncdRoutes.erase(it_route);
+    m_routeIndex.erase(ipPrefix);
+}
+
+/*
+ * Remember the route key the route is synced from, so that the updates
+ * announcing it again are found without parsing them. Only the keys in the
+ * canonical prefix format are kept, one per route, so that the key of a route
+ * is known from its prefix.
+ */
+void RouteOrch::setSyncdRouteKey(SyncdRouteTable::iterator it_route, const string &key)
+{
+    SyncdRoute &route = it_route->second;
+
+    if (route.keyed || key != it_route->first.to_string())
+    {
+        return;
+    }
+
+    m_syncdRouteKeys.emplace(key, it_route);
+    route.keyed = true;
+}
+
+void RouteOrch::eraseSyncdRouteKey(SyncdRouteTable::iterator it_route)
+{
+    SyncdRoute &route = it_route->second;
+
+    if (route.keyed)
+    {
+        m_syncdRouteKeys.erase(it_route->first.to_string());
+        route.keyed = false;
+    }
+}
+
+/*
+ * Check whether the update announces the route with the next hops it is
+ * synced with, with one lookup of the route key and a comparison with the
+ * canonical string of the next hops. Next hops in another order are left
+ * to be parsed.
+ */
+bool RouteOrch::isDuplicateRoute(const string &key, const KeyOpFieldsValuesTuple &t)
+{
+    auto it_key = m_syncdRouteKeys.find(key);
+    if (it_key == m_syncdRouteKeys.end())
+    {
+        return false;
+    }
+
+    SyncdRoute &route = it_key->second->second;
+    bool found = false;
+
+    for (const auto &i : kfvFieldsValues(t))
+    {
+        if (fvField(i) == "nexthop")
+        {
+            if (fvValue(i) != route.nexthops.to_string())
+            {
+                return false;
+            }
+            found = true;
+        }
+        else if (fvField(i) == "ifname")
+        {
+            /* Let the routes moved to these interfaces be removed */
+            const string &alias = fvValue(i);
+            if (isHostInterface(alias))
+            {
+                return false;
+            }
+        }
+    }
+
+    if (!found)
+    {
+        return false;
+    }
+
+    m_fastDuplicateRoutes++;
+    refreshRoute(route);
+    return true;
+}
+
+/* The route is announced again with the next hops it is synced with */
+void RouteOrch::refreshRoute(SyncdRoute &route)
+{
+    m_duplicateRoutes++;
+
+    if (m_resync && route.epoch != m_resyncEpoch)
+    {
+        route.epoch = m_resyncEpoch;
+        m_resyncRefreshed++;
+    }
+}
+
+/* Report the number of routes and the memory used by the route table */
+void RouteOrch::getTableStats(const string &tableName, vector<FieldValueTuple> &fvs) const
+{
+    if (tableName != APP_ROUTE_TABLE_NAME)
+    {
+        return;
+    }
+
+    /* Map node: color and 3 pointers. Hash node: next pointer and cached hash */
+    size_t route_bytes = m_syncdRoutes.size() * (sizeof(SyncdRouteTable::value_type) + 4 * sizeof(void *));
+    route_bytes += m_syncdRouteKeys.bucket_count() * sizeof(void *);
+    for (const auto &entry : m_syncdRouteKeys)
+    {
+        route_bytes += sizeof(entry) + 2 * sizeof(void *) + stringHeapBytes(entry.first);
+    }
+
+    fvs.emplace_back("routes", to_string(m_syncdRoutes.size()));
+    fvs.emplace_back("route_table_bytes", to_string(route_bytes));
+    fvs.emplace_back("route_index_bytes", to_string(m_routeIndex.memoryUsage()));
+    fvs.emplace_back("nexthop_sets", to_string(NextHopSet::poolSize()));
+    fvs.emplace_back("nexthop_set_bytes", to_string(NextHopSet::memoryUsage()));
+    fvs.emplace_back("resync_state", m_resync ? "resync" : m_resyncSweeping ? "sweep" : "idle");
+    fvs.emplace_back("resync_epoch", to_string(m_resyncEpoch));
+    fvs.emplace_back("resync_refreshed", to_string(m_resyncRefreshed));
+    fvs.emplace_back("resync_swept", to_string(m_resyncSwept));
+    fvs.emplace_back("resync_removed", to_string(m_resyncRemoved));
+    fvs.emplace_back("duplicate_routes", to_string(m_duplicateRoutes));
+    fvs.emplace_back("duplicate_routes_unparsed", to_string(m_fastDuplicateRoutes));
+
+    for (size_t i = 0; !m_routeClasses.empty() && i < m_routeClassStats.size(); i++)
+    {
+        const auto &stats = m_routeClassStats[i];
+        string name = "class_" + (i < m_routeClasses.size() ? m_routeClasses[i].name : string("default"));
+
+        fvs.emplace_back(name + "_routes", to_string(stats.routes));
+        fvs.emplace_back(name + "_avg_latency_us", to_string(stats.routes ? stats.total_latency_us / stats.routes : 0));
+        fvs.emplace_back(name + "_max_latency_us", to_string(stats.max_latency_us));
+    }
+}
+
+void RouteOrch::increaseNextHopRefCount(IpAddresses ipAddresses)
+{
+    /* Return when there is no next hop (dropped) */
+    if (ipAddresses.getSize() == 0)
+    {
+        return;
+    }
+    else if (ipAddresses.getSize() == 1)
+    {
+        IpAddress ip_address(ipAddresses.to_string());
+        m_neighOrch->increaseNextHopRefCount(ip_address);
+    }
+    else
+    {
+        m_syncdNextHopGroups[ipAddresses].ref_count ++;
+    }
+}
+void RouteOrch::decreaseNextHopRefCount(IpAddresses ipAddresses)
+{
+    /* Return when there is no next hop (dropped) */
+    if (ipAddresses.getSize() == 0)
+    {
+        return;
+    }
+    else if (ipAddresses.getSize() == 1)
+    {
+        IpAddress ip_address(ipAddresses.to_string());
+
+        m_neighOrch->decreaseNextHopRefCount(ip_address);
+    }
+    else
+    {
+        m_syncdNextHopGroups[ipAddresses].ref_count --;
+    }
+}
+
+bool RouteOrch::isRefCounterZero(const IpAddresses& ipAddresses) const
+{
+    if (!hasNextHopGroup(ipAddresses))
+    {
+        return true;
+    }
+
+    return m_syncdNextHopGroups.at(ipAddresses).ref_count == 0;
+}
+
+bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
+{
+    SWSS_LOG_ENTER();
+
+    assert(!hasNextHopGroup(ipAddresses));
+
+    if (m_nextHopGroupCount >= m_maxNextHopGroupCount)
+    {
+        SWSS_LOG_DEBUG("Failed to create new next hop group. \
+                        Reaching maximum number of next hop groups.");
+        return false;
+    }
+
+    set<IpAddress> next_hop_set = ipAddresses.getIpAddresses();
+
+    /* Assert each IP address exists in m_syncdNextHops table */
+    for (auto it : next_hop_set)
+    {
+        if (!m_neighOrch->hasNextHop(it))
+        {
+            SWSS_LOG_INFO("Failed to get next hop %s in %s",
+                    it.to_string().c_str(), ipAddresses.to_string().c_str());
+            return false;
+        }
+    }
+
+    sai_attribute_t nhg_attr;
+    vector<sai_attribute_t> nhg_attrs;
+
+    nhg_attr.id = SAI_NEXT_HOP_GROUP_ATTR_TYPE;
+    nhg_attr.value.s32 = SAI_NEXT_HOP_GROUP_TYPE_ECMP;
+    nhg_attrs.push_back(nhg_attr);
+
+    sai_object_id_t next_hop_group_id;
+    sai_status_t status = sai_next_hop_group_api->create_next_hop_group(&next_hop_group_id,
+                                                                        gSwitchId,
+                                                                        (uint32_t)nhg_attrs.size(),
+                                                                        nhg_attrs.data());
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create next hop group %s, rv:%d",
+                       ipAddresses.to_string().c_str(), status);
+        return false;
+    }
+
+    m_nextHopGroupCount ++;
+    SWSS_LOG_NOTICE("Create next hop group %s", ipAddresses.to_string().c_str());
+
+    gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
+
+    NextHopGroupEntry next_hop_group_entry;
+    next_hop_group_entry.next_hop_group_id = next_hop_group_id;
+
+    /*
+     * Create the next hop group members in one bulk call. The members of
+     * the next hops whose interfaces are down are not created; they are
+     * added back by validnexthopsinNextHopGroups() once the interfaces are up.
+     */
+    vector<IpAddress> nhgm_ips;
+    vector<sai_object_id_t> nhgm_ids(next_hop_set.size());
+    vector<sai_status_t> nhgm_statuses(next_hop_set.size());
+
+    for (auto nhop : next_hop_set)
+    {
+        if (m_neighOrch->isNextHopFlagSet(nhop, NHFLAGS_IFDOWN))
+        {
+            next_hop_group_entry.nhopgroup_members[nhop] = SAI_NULL_OBJECT_ID;
+            continue;
+        }
+
+        vector<sai_attribute_t> nhgm_attrs;
+
+        sai_attribute_t nhgm_attr;
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+        nhgm_attr.value.oid = next_hop_group_id;
+        nhgm_attrs.push_back(nhgm_attr);
+
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        nhgm_attr.value.oid = m_neighOrch->getNextHopId(nhop);
+        nhgm_attrs.push_back(nhgm_attr);
+
+        size_t i = nhgm_ips.size();
+        nhgm_ips.push_back(nhop);
+        m_nextHopGroupMemberBulker.create_entry(&nhgm_statuses[i], &nhgm_ids[i],
+                                                (uint32_t)nhgm_attrs.size(), nhgm_attrs.data());
+    }
+
+    m_nextHopGroupMemberBulker.flush();
+
+    bool success = true;
+    for (size_t i = 0; i < nhgm_ips.size(); i++)
+    {
+        if (nhgm_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create next hop group %lx member %s, rv:%d",
+                           next_hop_group_id, nhgm_ips[i].to_string().c_str(), nhgm_statuses[i]);
+            success = false;
+            continue;
         }
 
         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
 
-        // Save the membership into next hop structure
-        next_hop_group_entry.nhopgroup_members[nhopgroup_members_set.find(nhid)->second] =
-                                                                next_hop_group_member_id;
+        // Save the membership into next hop structure
+        next_hop_group_entry.nhopgroup_members[nhgm_ips[i]] = nhgm_ids[i];
+    }
+
+    if (!success)
+    {
+        /* Roll back the members created and the next hop group */
+        for (auto it = next_hop_group_entry.nhopgroup_members.begin();
+             it != next_hop_group_entry.nhopgroup_members.end();)
+        {
+            if (it->second == SAI_NULL_OBJECT_ID)
+            {
+                it = next_hop_group_entry.nhopgroup_members.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
+
+        if (!removeNextHopGroupMembers(next_hop_group_entry.nhopgroup_members))
+        {
+            SWSS_LOG_ERROR("Failed to roll back next hop group %s members",
+                           ipAddresses.to_string().c_str());
+        }
+
+        status = sai_next_hop_group_api->remove_next_hop_group(next_hop_group_id);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove next hop group %lx, rv:%d", next_hop_group_id, status);
+        }
+
+        m_nextHopGroupCount --;
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
+
+        return false;
     }
 
     /* Increment the ref_count for the next hops used by the next hop group. */
@@ -606,24 +1419,230 @@ bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
      * count will increase once the route is successfully syncd.
      */
     next_hop_group_entry.ref_count = 0;
-    m_syncdNextHopGroups[ipAddresses] = next_hop_group_entry;
+    NextHopGroupEntry &nhopgroup = m_syncdNextHopGroups[ipAddresses] = next_hop_group_entry;
+
+    for (auto it : next_hop_set)
+    {
+        m_nextHopGroupIndex[it].insert(&nhopgroup);
+    }
+
+    return true;
+}
 
-    for (auto nhop : next_hop_set) {
-        if (!m_neighOrch->isNextHopFlagSet(nhop, NHFLAGS_IFDOWN)) {
+/*
+ * Remove the next hop group members in one bulk call. The members of the next
+ * hops whose interfaces are down are already removed and are skipped. Removed
+ * members are erased from the table, and the failed ones are kept for retry.
+ */
+bool RouteOrch::removeNextHopGroupMembers(NextHopGroupMembers& members)
+{
+    SWSS_LOG_ENTER();
+
+    vector<NextHopGroupMembers::iterator> nhgm_its;
+    vector<sai_status_t> nhgm_statuses(members.size());
+
+    for (auto nhop = members.begin(); nhop != members.end();)
+    {
+        if (nhop->second == SAI_NULL_OBJECT_ID ||
+            m_neighOrch->isNextHopFlagSet(nhop->first, NHFLAGS_IFDOWN))
+        {
+            nhop = members.erase(nhop);
             continue;
         }
 
-        next_hop_id = next_hop_group_entry.nhopgroup_members[nhop];
-        status = sai_next_hop_group_api->remove_next_hop_group_member(next_hop_id);
+        m_nextHopGroupMemberBulker.remove_entry(&nhgm_statuses[nhgm_its.size()], nhop->second);
+        nhgm_its.push_back(nhop);
+        nhop++;
+    }
+
+    m_nextHopGroupMemberBulker.flush();
 
-        if (status != SAI_STATUS_SUCCESS) {
-            SWSS_LOG_ERROR("Failed to remove next hop group member %lx: %d\n",
-                           next_hop_id, status);
+    bool success = true;
+    for (size_t i = 0; i < nhgm_its.size(); i++)
+    {
+        if (nhgm_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove next hop group member %lx, rv:%d",
+                           nhgm_its[i]->second, nhgm_statuses[i]);
+            success = false;
+            continue;
         }
 
         gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+        members.erase(nhgm_its[i]);
+    }
+
+    return success;
+}
+
+/*
+ * Update the members of the next hop group in place from the current next
+ * hops to the given ones, creating and removing only the members that differ,
+ * and re-key the group by the new next hops. Return false, with the group
+ * unchanged, if the new members cannot be created.
+ *
+ * A member that fails to be removed stays in the group, with the reference to
+ * its next hop, until a later update or the removal of the group removes it.
+ */
+bool RouteOrch::updateNextHopGroup(const IpAddresses &current, const IpAddresses &nextHops)
+{
+    SWSS_LOG_ENTER();
+
+    auto it_nhg = m_syncdNextHopGroups.find(current);
+    assert(it_nhg != m_syncdNextHopGroups.end());
+
+    set<IpAddress> current_set = current.getIpAddresses();
+    set<IpAddress> next_hop_set = nextHops.getIpAddresses();
+
+    for (auto it : next_hop_set)
+    {
+        if (!m_neighOrch->hasNextHop(it))
+        {
+            SWSS_LOG_INFO("Failed to get next hop %s in %s",
+                    it.to_string().c_str(), nextHops.to_string().c_str());
+            return false;
+        }
+    }
+
+    NextHopGroupEntry next_hop_group_entry = it_nhg->second;
+    sai_object_id_t next_hop_group_id = next_hop_group_entry.next_hop_group_id;
+
+    /* Next hops referenced by the group: its next hops and the members left */
+    set<IpAddress> referenced = current_set;
+    for (const auto &member : next_hop_group_entry.nhopgroup_members)
+    {
+        referenced.insert(member.first);
+    }
+
+    /* Create the added members first, so that the group is never empty */
+    vector<IpAddress> nhgm_ips;
+    vector<sai_object_id_t> nhgm_ids(next_hop_set.size());
+    vector<sai_status_t> nhgm_statuses(next_hop_set.size());
+
+    for (auto nhop : next_hop_set)
+    {
+        if (referenced.find(nhop) != referenced.end())
+        {
+            continue;
+        }
+
+        if (m_neighOrch->isNextHopFlagSet(nhop, NHFLAGS_IFDOWN))
+        {
+            next_hop_group_entry.nhopgroup_members[nhop] = SAI_NULL_OBJECT_ID;
+            continue;
+        }
+
+        vector<sai_attribute_t> nhgm_attrs;
+
+        sai_attribute_t nhgm_attr;
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+        nhgm_attr.value.oid = next_hop_group_id;
+        nhgm_attrs.push_back(nhgm_attr);
+
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        nhgm_attr.value.oid = m_neighOrch->getNextHopId(nhop);
+        nhgm_attrs.push_back(nhgm_attr);
+
+        size_t i = nhgm_ips.size();
+        nhgm_ips.push_back(nhop);
+        m_nextHopGroupMemberBulker.create_entry(&nhgm_statuses[i], &nhgm_ids[i],
+                                                (uint32_t)nhgm_attrs.size(), nhgm_attrs.data());
+    }
+
+    m_nextHopGroupMemberBulker.flush();
+
+    NextHopGroupMembers created;
+    bool success = true;
+    for (size_t i = 0; i < nhgm_ips.size(); i++)
+    {
+        if (nhgm_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create next hop group %lx member %s, rv:%d",
+                           next_hop_group_id, nhgm_ips[i].to_string().c_str(), nhgm_statuses[i]);
+            success = false;
+            continue;
+        }
+
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+        created[nhgm_ips[i]] = nhgm_ids[i];
+    }
+
+    if (!success)
+    {
+        /* Roll back the members created, the group keeps its current next hops */
+        if (!removeNextHopGroupMembers(created))
+        {
+            SWSS_LOG_ERROR("Failed to roll back next hop group %s members",
+                           nextHops.to_string().c_str());
+        }
+        return false;
+    }
+
+    next_hop_group_entry.nhopgroup_members.insert(created.begin(), created.end());
+
+    /* Remove the members of the next hops that are not in the group anymore */
+    NextHopGroupMembers removed;
+    for (auto nhop = next_hop_group_entry.nhopgroup_members.begin();
+         nhop != next_hop_group_entry.nhopgroup_members.end();)
+    {
+        if (next_hop_set.find(nhop->first) != next_hop_set.end())
+        {
+            nhop++;
+            continue;
+        }
+
+        removed.insert(*nhop);
+        nhop = next_hop_group_entry.nhopgroup_members.erase(nhop);
+    }
+
+    if (!removeNextHopGroupMembers(removed))
+    {
+        /* The members failed to be removed are still in SAI, keep them */
+        SWSS_LOG_ERROR("Failed to remove next hop group %s members",
+                       current.to_string().c_str());
+        next_hop_group_entry.nhopgroup_members.insert(removed.begin(), removed.end());
+    }
+
+    set<IpAddress> still_referenced = next_hop_set;
+    for (const auto &member : removed)
+    {
+        still_referenced.insert(member.first);
+    }
+
+    for (auto it : still_referenced)
+    {
+        if (referenced.find(it) == referenced.end())
+        {
+            m_neighOrch->increaseNextHopRefCount(it);
+        }
     }
 
+    for (auto it : referenced)
+    {
+        if (still_referenced.find(it) == still_referenced.end())
+        {
+            m_neighOrch->decreaseNextHopRefCount(it);
+        }
+
+        auto groups = m_nextHopGroupIndex.find(it);
+        groups->second.erase(&it_nhg->second);
+        if (groups->second.empty())
+        {
+            m_nextHopGroupIndex.erase(groups);
+        }
+    }
+
+    m_syncdNextHopGroups.erase(it_nhg);
+    NextHopGroupEntry &nhopgroup = m_syncdNextHopGroups[nextHops] = next_hop_group_entry;
+
+    for (auto it : still_referenced)
+    {
+        m_nextHopGroupIndex[it].insert(&nhopgroup);
+    }
+
+    SWSS_LOG_NOTICE("Update next hop group %s to %s",
+                    current.to_string().c_str(), nextHops.to_string().c_str());
+
     return true;
 }
 
@@ -645,25 +1664,17 @@ bool RouteOrch::removeNextHopGroup(IpAddresses ipAddresses)
     next_hop_group_id = next_hop_group_entry->second.next_hop_group_id;
     SWSS_LOG_NOTICE("Delete next hop group %s", ipAddresses.to_string().c_str());
 
-    for (auto nhop = next_hop_group_entry->second.nhopgroup_members.begin();
-         nhop != next_hop_group_entry->second.nhopgroup_members.end();)
+    /* Next hops referenced by the group: its next hops and the members left
+     * by a failed update */
+    set<IpAddress> ip_address_set = ipAddresses.getIpAddresses();
+    for (const auto &member : next_hop_group_entry->second.nhopgroup_members)
     {
+        ip_address_set.insert(member.first);
+    }
 
-        if (m_neighOrch->isNextHopFlagSet(nhop->first, NHFLAGS_IFDOWN))
-        {
-            nhop = next_hop_group_entry->second.nhopgroup_members.erase(nhop);
-            continue;
-        }
-        status = sai_next_hop_group_api->remove_next_hop_group_member(nhop->second);
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to remove next hop group member %lx, rv:%d",
-                           nhop->second, status);
-            return false;
-        }
-
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
-        nhop = next_hop_group_entry->second.nhopgroup_members.erase(nhop);
+    if (!removeNextHopGroupMembers(next_hop_group_entry->second.nhopgroup_members))
+    {
+        return false;
     }
 
     status = sai_next_hop_group_api->remove_next_hop_group(next_hop_group_id);
@@ -676,20 +1687,28 @@ bool RouteOrch::removeNextHopGroup(IpAddresses ipAddresses)
     m_nextHopGroupCount --;
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
 
-    set<IpAddress> ip_address_set = ipAddresses.getIpAddresses();
     for (auto it : ip_address_set)
     {
         m_neighOrch->decreaseNextHopRefCount(it);
+
+        auto groups = m_nextHopGroupIndex.find(it);
+        groups->second.erase(&next_hop_group_entry->second);
+        if (groups->second.empty())
+        {
+            m_nextHopGroupIndex.erase(groups);
+        }
     }
-    m_syncdNextHopGroups.erase(ipAddresses);
+    m_syncdNextHopGroups.erase(next_hop_group_entry);
 
     return true;
 }
 
-void RouteOrch::addTempRoute(IpPrefix ipPrefix, IpAddresses nextHops)
+bool RouteOrch::addTempRoute(RouteBulkContext& ctx, const IpAddresses &nextHops)
 {
     SWSS_LOG_ENTER();
 
+    IpPrefix& ipPrefix = ctx.ip_prefix;
+
     auto next_hop_set = nextHops.getIpAddresses();
 
     /* Remove next hops that are not in m_syncdNextHops */
@@ -707,7 +1726,7 @@ void RouteOrch::addTempRoute(IpPrefix ipPrefix, IpAddresses nextHops)
 
     /* Return if next_hop_set is empty */
     if (next_hop_set.empty())
-        return;
+        return false;
 
     /* Randomly pick an address from the set */
     auto it = next_hop_set.begin();
@@ -715,13 +1734,28 @@ void RouteOrch::addTempRoute(IpPrefix ipPrefix, IpAddresses nextHops)
 
     /* Set the route's temporary next hop to be the randomly picked one */
     IpAddresses tmp_next_hop((*it).to_string());
-    addRoute(ipPrefix, tmp_next_hop);
+    if (!addRoute(ctx, tmp_next_hop))
+    {
+        return false;
+    }
+
+    ctx.using_temp_nhg = true;
+    ctx.requested_nhg = nextHops;
+    return true;
 }
 
-bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
+/*
+ * Queue the SAI operations to sync the route to the given next hop(s).
+ * Return true if the operations are queued to the route bulker, and the
+ * result has to be reconciled by addRoutePost() after the bulker is flushed.
+ * Return false if the route cannot be programmed in this pass.
+ */
+bool RouteOrch::addRoute(RouteBulkContext& ctx, const IpAddresses &nextHops)
 {
     SWSS_LOG_ENTER();
 
+    IpPrefix& ipPrefix = ctx.ip_prefix;
+
     /* next_hop_id indicates the next hop id or next hop group id of this route */
     sai_object_id_t next_hop_id;
     auto it_route = m_syncdRoutes.find(ipPrefix);
@@ -747,6 +1781,21 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
         /* Check if there is already an existing next hop group */
         if (!hasNextHopGroup(nextHops))
         {
+            /*
+             * Update the members of the current next hop group of the route
+             * in place when no other route or user is referencing it
+             */
+            if (gNhgInPlaceUpdate && it_route != m_syncdRoutes.end()
+                && it_route->second.nexthops->getSize() > 1
+                && m_syncdNextHopGroups[*it_route->second.nexthops].ref_count == 1
+                && updateNextHopGroup(*it_route->second.nexthops, nextHops))
+            {
+                /* The route keeps pointing to the group and its reference */
+                ctx.nhg = nextHops;
+                ctx.nhg_updated = true;
+                return true;
+            }
+
             /* Try to create a new next hop group */
             if (!addNextHopGroup(nextHops))
             {
@@ -754,9 +1803,9 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
 
                 /* If the current next hop is part of the next hop group to sync,
                  * then return false and no need to add another temporary route. */
-                if (it_route != m_syncdRoutes.end() && it_route->second.getSize() == 1)
+                if (it_route != m_syncdRoutes.end() && it_route->second.nexthops->getSize() == 1)
                 {
-                    IpAddress ip_address(it_route->second.to_string());
+                    IpAddress ip_address(it_route->second.nexthops->to_string());
                     if (nextHops.contains(ip_address))
                     {
                         return false;
@@ -765,10 +1814,9 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
 
                 /* Add a temporary route when a next hop group cannot be added,
                  * and there is no temporary route right now or the current temporary
-                 * route is not pointing to a member of the next hop group to sync. */
-                addTempRoute(ipPrefix, nextHops);
-                /* Return false since the original route is not successfully added */
-                return false;
+                 * route is not pointing to a member of the next hop group to sync.
+                 * The original route is kept for retry by addRoutePost(). */
+                return addTempRoute(ctx, nextHops);
             }
         }
 
@@ -787,7 +1835,7 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
      * for this prefix with the new next hop (group) id. If the prefix is already
      * in m_syncdRoutes, then we need to update the route with a new next hop
      * (group) id. The old next hop (group) is then not used and the reference
-     * count will decrease by 1.
+     * count will decrease by 1 in addRoutePost().
      */
     if (it_route == m_syncdRoutes.end())
     {
@@ -795,87 +1843,135 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
         route_attr.value.oid = next_hop_id;
 
         /* Default SAI_ROUTE_ATTR_PACKET_ACTION is SAI_PACKET_ACTION_FORWARD */
-        sai_status_t status = sai_route_api->create_route_entry(&route_entry, 1, &route_attr);
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to create route %s with next hop(s) %s",
-                    ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
-            /* Clean up the newly created next hop group entry */
-            if (nextHops.getSize() > 1)
-            {
-                removeNextHopGroup(nextHops);
-            }
-            return false;
-        }
-
-        if (route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-        {
-            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
-        }
-        else
-        {
-            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
-        }
-
-        /* Increase the ref_count for the next hop (group) entry */
-        increaseNextHopRefCount(nextHops);
-        SWSS_LOG_INFO("Create route %s with next hop(s) %s",
-                ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
+        ctx.object_statuses.emplace_back();
+        m_routeBulker.create_entry(&ctx.object_statuses.back(), &route_entry, 1, &route_attr);
     }
     else
     {
-        sai_status_t status;
-
         /* Set the packet action to forward when there was no next hop (dropped) */
-        if (it_route->second.getSize() == 0)
+        if (it_route->second.nexthops->getSize() == 0)
         {
             route_attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
             route_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
 
-            status = sai_route_api->set_route_entry_attribute(&route_entry, &route_attr);
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("Failed to set route %s with packet action forward, %d",
-                               ipPrefix.to_string().c_str(), status);
-                return false;
-            }
+            ctx.object_statuses.emplace_back();
+            m_routeBulker.set_entry_attribute(&ctx.object_statuses.back(), &route_entry, &route_attr);
         }
 
         route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
         route_attr.value.oid = next_hop_id;
 
         /* Set the next hop ID to a new value */
-        status = sai_route_api->set_route_entry_attribute(&route_entry, &route_attr);
-        if (status != SAI_STATUS_SUCCESS)
+        ctx.object_statuses.emplace_back();
+        m_routeBulker.set_entry_attribute(&ctx.object_statuses.back(), &route_entry, &route_attr);
+    }
+
+    /*
+     * Increase the ref_count for the next hop (group) entry while the route
+     * operation is pending, so that the next hop group cannot be removed by
+     * another route of the same pass before the bulker is flushed.
+     */
+    increaseNextHopRefCount(nextHops);
+    ctx.nhg = nextHops;
+
+    return true;
+}
+
+/*
+ * Reconcile the bulk statuses of a route queued by addRoute().
+ * Return true if the route is synced with the requested next hop(s).
+ */
+bool RouteOrch::addRoutePost(RouteBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const IpPrefix& ipPrefix = ctx.ip_prefix;
+    const IpAddresses& nextHops = ctx.nhg;
+
+    auto it_route = m_syncdRoutes.find(ipPrefix);
+
+    for (auto status : ctx.object_statuses)
+    {
+        if (status == SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("Failed to set route %s with next hop(s) %s",
-                    ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
-            return false;
+            continue;
+        }
+
+        if (it_route == m_syncdRoutes.end())
+        {
+            SWSS_LOG_ERROR("Failed to create route %s with next hop(s) %s, rv:%d",
+                    ipPrefix.to_string().c_str(), nextHops.to_string().c_str(), status);
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to set route %s with next hop(s) %s, rv:%d",
+                    ipPrefix.to_string().c_str(), nextHops.to_string().c_str(), status);
+        }
+
+        /* Release the reference taken in addRoute() and clean up the next
+         * hop group entry if no other route is using it */
+        decreaseNextHopRefCount(nextHops);
+        if (nextHops.getSize() > 1 && isRefCounterZero(nextHops))
+        {
+            removeNextHopGroup(nextHops);
         }
+        return false;
+    }
 
-        /* Increase the ref_count for the next hop (group) entry */
-        increaseNextHopRefCount(nextHops);
+    if (it_route == m_syncdRoutes.end())
+    {
+        if (ipPrefix.isV4())
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        }
+        else
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
+        }
 
-        decreaseNextHopRefCount(it_route->second);
-        if (it_route->second.getSize() > 1
-            && m_syncdNextHopGroups[it_route->second].ref_count == 0)
+        SWSS_LOG_INFO("Create route %s with next hop(s) %s",
+                ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
+    }
+    else if (ctx.nhg_updated)
+    {
+        SWSS_LOG_INFO("Update route %s next hop group to %s",
+                ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
+    }
+    else
+    {
+        decreaseNextHopRefCount(*it_route->second.nexthops);
+        if (it_route->second.nexthops->getSize() > 1
+            && m_syncdNextHopGroups[*it_route->second.nexthops].ref_count == 0)
         {
-            removeNextHopGroup(it_route->second);
+            removeNextHopGroup(*it_route->second.nexthops);
         }
         SWSS_LOG_INFO("Set route %s with next hop(s) %s",
                 ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
     }
 
-    m_syncdRoutes[ipPrefix] = nextHops;
+    setSyncdRoute(ipPrefix, nextHops);
+
+    if (!ctx.key.empty())
+    {
+        setSyncdRouteKey(m_syncdRoutes.find(ipPrefix), ctx.key);
+    }
 
     notifyNextHopChangeObservers(ipPrefix, nextHops, true);
-    return true;
+
+    /* A temporary route is synced, keep the original route for retry */
+    return !ctx.using_temp_nhg;
 }
 
-bool RouteOrch::removeRoute(IpPrefix ipPrefix)
+/*
+ * Queue the SAI operations to remove the route. The default route is not
+ * removed but set to drop.
+ */
+bool RouteOrch::removeRoute(RouteBulkContext& ctx)
 {
     SWSS_LOG_ENTER();
 
+    IpPrefix& ipPrefix = ctx.ip_prefix;
+
     sai_route_entry_t route_entry;
     route_entry.vr_id = gVirtualRouterId;
     route_entry.switch_id = gSwitchId;
@@ -888,7 +1984,40 @@ bool RouteOrch::removeRoute(IpPrefix ipPrefix)
         attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
         attr.value.s32 = SAI_PACKET_ACTION_DROP;
 
-        sai_status_t status = sai_route_api->set_route_entry_attribute(&route_entry, &attr);
+        ctx.object_statuses.emplace_back();
+        m_routeBulker.set_entry_attribute(&ctx.object_statuses.back(), &route_entry, &attr);
+
+        attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+        attr.value.oid = SAI_NULL_OBJECT_ID;
+
+        ctx.object_statuses.emplace_back();
+        m_routeBulker.set_entry_attribute(&ctx.object_statuses.back(), &route_entry, &attr);
+    }
+    else
+    {
+        ctx.object_statuses.emplace_back();
+        m_routeBulker.remove_entry(&ctx.object_statuses.back(), &route_entry);
+    }
+
+    return true;
+}
+
+/*
+ * Reconcile the bulk statuses of a route queued by removeRoute().
+ * Return true if the route is removed.
+ */
+bool RouteOrch::removeRoutePost(RouteBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const IpPrefix& ipPrefix = ctx.ip_prefix;
+
+    auto it_status = ctx.object_statuses.begin();
+    sai_status_t status;
+
+    if (ipPrefix.isDefaultRoute())
+    {
+        status = *it_status++;
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to set route %s packet action to drop, rv:%d",
@@ -898,10 +2027,7 @@ bool RouteOrch::removeRoute(IpPrefix ipPrefix)
 
         SWSS_LOG_INFO("Set route %s packet action to drop", ipPrefix.to_string().c_str());
 
-        attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
-        attr.value.oid = SAI_NULL_OBJECT_ID;
-
-        status = sai_route_api->set_route_entry_attribute(&route_entry, &attr);
+        status = *it_status++;
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to set route %s next hop ID to NULL, rv:%d",
@@ -913,14 +2039,15 @@ bool RouteOrch::removeRoute(IpPrefix ipPrefix)
     }
     else
     {
-        sai_status_t status = sai_route_api->remove_route_entry(&route_entry);
+        status = *it_status++;
         if (status != SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("Failed to remove route prefix:%s\n", ipPrefix.to_string().c_str());
+            SWSS_LOG_ERROR("Failed to remove route prefix:%s, rv:%d",
+                    ipPrefix.to_string().c_str(), status);
             return false;
         }
 
-        if (route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        if (ipPrefix.isV4())
         {
             gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
         }
@@ -928,8 +2055,8 @@ bool RouteOrch::removeRoute(IpPrefix ipPrefix)
         {
             gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
         }
-
     }
+
     /* Remove next hop group entry if ref_count is zero */
     auto it_route = m_syncdRoutes.find(ipPrefix);
     if (it_route != m_syncdRoutes.end())
@@ -940,26 +2067,27 @@ bool RouteOrch::removeRoute(IpPrefix ipPrefix)
          * and check wheather the reference count decreases to zero. If yes, then we need
          * to remove the next hop group.
          */
-        decreaseNextHopRefCount(it_route->second);
-        if (it_route->second.getSize() > 1
-            && m_syncdNextHopGroups[it_route->second].ref_count == 0)
+        decreaseNextHopRefCount(*it_route->second.nexthops);
+        if (it_route->second.nexthops->getSize() > 1
+            && m_syncdNextHopGroups[*it_route->second.nexthops].ref_count == 0)
         {
-            removeNextHopGroup(it_route->second);
+            removeNextHopGroup(*it_route->second.nexthops);
         }
+
+        SWSS_LOG_INFO("Remove route %s with next hop(s) %s",
+                ipPrefix.to_string().c_str(), it_route->second.nexthops->to_string().c_str());
     }
-    SWSS_LOG_INFO("Remove route %s with next hop(s) %s",
-            ipPrefix.to_string().c_str(), it_route->second.to_string().c_str());
 
     if (ipPrefix.isDefaultRoute())
     {
-        m_syncdRoutes[ipPrefix] = IpAddresses();
+        setSyncdRoute(ipPrefix, IpAddresses());
 
         /* Notify about default route next hop change */
-        notifyNextHopChangeObservers(ipPrefix, m_syncdRoutes[ipPrefix], true);
+        notifyNextHopChangeObservers(ipPrefix, IpAddresses(), true);
     }
     else
     {
-        m_syncdRoutes.erase(ipPrefix);
+        eraseSyncdRoute(ipPrefix);
 
         /* Notify about the route next hop removal */
         notifyNextHopChangeObservers(ipPrefix, IpAddresses(), false);
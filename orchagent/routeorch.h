@@ -9,12 +9,21 @@
 #include "ipaddress.h"
 #include "ipaddresses.h"
 #include "ipprefix.h"
+#include "bulker.h"
+#include "prefixtrie.h"
+#include "nexthopset.h"
 
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <deque>
+#include <chrono>
 
 /* Maximum next hop group number */
 #define NHGRP_MAX_SIZE 128
 
+#define CFG_ROUTE_PRIORITY_TABLE_NAME "ROUTE_PRIORITY"
+
 typedef std::map<IpAddress, sai_object_id_t> NextHopGroupMembers;
 
 struct NextHopGroupEntry
@@ -34,21 +43,87 @@ struct NextHopObserverEntry;
 
 /* NextHopGroupTable: next hop group IP addersses, NextHopGroupEntry */
 typedef std::map<IpAddresses, NextHopGroupEntry> NextHopGroupTable;
-/* RouteTable: destination network, next hop IP address(es) */
-typedef std::map<IpPrefix, IpAddresses> RouteTable;
+/* NextHopGroupIndex: next hop IP address, entries of the groups it is a member of */
+typedef std::map<IpAddress, std::set<NextHopGroupEntry *>> NextHopGroupIndex;
+/* RouteTable: destination network, interned next hop IP address(es) */
+typedef std::map<IpPrefix, NextHopSet> RouteTable;
 /* NextHopObserverTable: Destination IP address, next hop observer entry */
 typedef std::map<IpAddress, NextHopObserverEntry> NextHopObserverTable;
 
+/*
+ * Synced route: next hop IP address(es), resync generation it was last announced in,
+ * whether its route key is in the route key table
+ */
+struct SyncdRoute
+{
+    NextHopSet nexthops;
+    uint32_t epoch;
+    bool keyed;
+};
+
+/* SyncdRouteTable: destination network, synced route */
+typedef std::map<IpPrefix, SyncdRoute> SyncdRouteTable;
+/* SyncdRouteKeyTable: canonical route key as received from the application, synced route */
+typedef std::unordered_map<std::string, SyncdRouteTable::iterator> SyncdRouteKeyTable;
+
 struct NextHopObserverEntry
 {
     RouteTable routeTable;
     list<Observer *> observers;
 };
 
+/*
+ * Route priority class. The route tasks of a class are programmed before the
+ * ones of the classes with higher priority values. A route belongs to the
+ * first class whose configured criteria all match: prefix length, covering
+ * prefix, and value of a field of the route entry.
+ */
+struct RoutePriorityClass
+{
+    string name;
+    int priority;
+    set<int> prefix_lengths;
+    vector<IpPrefix> prefixes;
+    string field;
+    set<string> values;
+};
+
+/* Time from a route task being seen by RouteOrch to being done, per class */
+struct RoutePriorityStats
+{
+    size_t routes;
+    uint64_t total_latency_us;
+    uint64_t max_latency_us;
+};
+
+/* Route task pending in RouteOrch: class index, time it was first queued */
+struct PendingRouteTask
+{
+    size_t route_class;
+    std::chrono::steady_clock::time_point since;
+    bool queued;        // Whether it is to be classified in the next pass
+};
+
+struct RouteBulkContext
+{
+    std::deque<sai_status_t>            object_statuses;    // Bulk statuses
+    IpPrefix                            ip_prefix;          // Route prefix
+    IpAddresses                         nhg;                // Next hop(s) the route is programmed with
+    bool                                using_temp_nhg;     // Whether a temporary next hop is programmed
+    IpAddresses                         requested_nhg;      // Next hops requested when using a temporary next hop
+    bool                                nhg_updated;        // Whether the next hop group members are updated in place
+    std::string                         key;                // Route key as received from the application
+
+    RouteBulkContext(const IpPrefix &prefix)
+        : ip_prefix(prefix), using_temp_nhg(false), nhg_updated(false)
+    {
+    }
+};
+
 class RouteOrch : public Orch, public Subject
 {
 public:
-    RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch);
+    RouteOrch(DBConnector *db, string tableName, DBConnector *configDb, NeighOrch *neighOrch);
 
     bool hasNextHopGroup(const IpAddresses&) const;
     sai_object_id_t getNextHopGroupId(const IpAddresses&);
@@ -63,8 +138,11 @@ public:
     bool addNextHopGroup(IpAddresses);
     bool removeNextHopGroup(IpAddresses);
 
-    bool validnexthopinNextHopGroup(const IpAddress &);
-    bool invalidnexthopinNextHopGroup(const IpAddress &);
+    bool validnexthopsinNextHopGroups(const vector<IpAddress> &);
+    bool invalidnexthopsinNextHopGroups(const vector<IpAddress> &);
+
+    void getTableStats(const string &tableName, vector<FieldValueTuple> &fvs) const;
+    void onTaskQueued(Consumer &consumer, const string &key);
 
 private:
     NeighOrch *m_neighOrch;
@@ -73,16 +151,73 @@ private:
     int m_maxNextHopGroupCount;
     bool m_resync;
 
-    RouteTable m_syncdRoutes;
+    /* Generation of the routes announced since the last resync started */
+    uint32_t m_resyncEpoch;
+    /* Stale routes are removed in batches after the resync completes */
+    bool m_resyncSweeping;
+    IpPrefix m_resyncCursor;
+    SelectableTimer *m_resyncTimer;
+    /* Routes refreshed during the resync, examined and removed by the sweep */
+    size_t m_resyncRefreshed;
+    size_t m_resyncSwept;
+    size_t m_resyncRemoved;
+
+    /* Updates announcing the next hops a route is already synced with */
+    size_t m_duplicateRoutes;
+    size_t m_fastDuplicateRoutes;
+
+    /* Route priority classes by name, and ordered by priority */
+    map<string, RoutePriorityClass> m_routeClassConfig;
+    vector<RoutePriorityClass> m_routeClasses;
+    /* Latency stats of the classes, the last one for the routes of no class */
+    vector<RoutePriorityStats> m_routeClassStats;
+    unordered_map<string, PendingRouteTask> m_pendingRouteTasks;
+    /* Keys of the route tasks queued or updated since the last pass */
+    vector<string> m_queuedRouteTasks;
+
+    SyncdRouteTable m_syncdRoutes;
+    SyncdRouteKeyTable m_syncdRouteKeys;
     NextHopGroupTable m_syncdNextHopGroups;
+    NextHopGroupIndex m_nextHopGroupIndex;
 
     NextHopObserverTable m_nextHopObservers;
 
-    void addTempRoute(IpPrefix, IpAddresses);
-    bool addRoute(IpPrefix, IpAddresses);
-    bool removeRoute(IpPrefix);
+    /* Longest prefix match indexes of m_syncdRoutes and m_nextHopObservers */
+    IpPrefixTrie<SyncdRouteTable::iterator> m_routeIndex;
+    IpPrefixTrie<NextHopObserverTable::iterator> m_nextHopObserverIndex;
+
+    EntityBulker<sai_route_api_t> m_routeBulker;
+    ObjectBulker<sai_next_hop_group_api_t> m_nextHopGroupMemberBulker;
+
+    void setSyncdRoute(const IpPrefix&, const IpAddresses&);
+    void eraseSyncdRoute(const IpPrefix&);
+    void setSyncdRouteKey(SyncdRouteTable::iterator, const string&);
+    void eraseSyncdRouteKey(SyncdRouteTable::iterator);
+    bool isDuplicateRoute(const string&, const KeyOpFieldsValuesTuple&);
+    void refreshRoute(SyncdRoute&);
+
+    void prioritizeRoutes(SyncMap&);
+    size_t getRouteClass(const string&, const KeyOpFieldsValuesTuple&) const;
+    size_t getPendingRouteClass(const string&) const;
+    SyncMap::iterator eraseRouteTask(Consumer&, SyncMap::iterator);
+    SyncMap::iterator parkRouteTask(Consumer&, SyncMap::iterator, const Constraint&);
+    void doRoutePriorityTask(Consumer&);
+
+    bool removeNextHopGroupMembers(NextHopGroupMembers&);
+    bool updateNextHopGroup(const IpAddresses&, const IpAddresses&);
+    bool getMissingNextHop(const IpAddresses&, IpAddress&) const;
+
+    bool addTempRoute(RouteBulkContext& ctx, const IpAddresses&);
+    bool addRoute(RouteBulkContext& ctx, const IpAddresses&);
+    bool addRoutePost(RouteBulkContext& ctx);
+    bool removeRoute(RouteBulkContext& ctx);
+    bool removeRoutePost(RouteBulkContext& ctx);
+
+    void startResync();
+    void completeResync();
 
     void doTask(Consumer& consumer);
+    void doTask(SelectableTimer &timer);
 
     void notifyNextHopChangeObservers(IpPrefix, IpAddresses, bool);
 };
@@ -0,0 +1,191 @@
+#ifndef SWSS_SYNCMAP_H
+#define SWSS_SYNCMAP_H
+
+#include <list>
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+
+#include "table.h"
+
+/*
+ * SyncMap keeps the pending tasks of a Consumer, one task per key.
+ *
+ * The tasks are kept in a list in the order in which their keys are first
+ * queued, and a hash index on the key gives O(1) lookup. Iterators stay valid
+ * until the task they point to is erased, so the tasks can be erased while
+ * iterating as with std::map. The index refers to the key stored in the list
+ * node, so the key string is not duplicated.
+ */
+class SyncMap
+{
+public:
+    typedef std::string                                     key_type;
+    typedef swss::KeyOpFieldsValuesTuple                    mapped_type;
+    typedef std::pair<const key_type, mapped_type>          value_type;
+    typedef std::list<value_type>::iterator                 iterator;
+    typedef std::list<value_type>::const_iterator           const_iterator;
+
+    SyncMap() = default;
+
+    SyncMap(const SyncMap&) = delete;
+    SyncMap& operator=(const SyncMap&) = delete;
+
+    iterator begin() { return m_tasks.begin(); }
+    iterator end() { return m_tasks.end(); }
+    const_iterator begin() const { return m_tasks.begin(); }
+    const_iterator end() const { return m_tasks.end(); }
+
+    bool empty() const { return m_tasks.empty(); }
+    size_t size() const { return m_tasks.size(); }
+
+    iterator find(const key_type &key)
+    {
+        auto it = m_index.find(std::cref(key));
+        return it == m_index.end() ? m_tasks.end() : it->second;
+    }
+
+    size_t count(const key_type &key) const
+    {
+        return m_index.count(std::cref(key));
+    }
+
+    /* Return the task of the key, an empty task is queued if there is none */
+    mapped_type& operator[](const key_type &key)
+    {
+        auto it = m_index.find(std::cref(key));
+        if (it != m_index.end())
+        {
+            return it->second->second;
+        }
+
+        return insert(key, mapped_type())->second;
+    }
+
+    iterator erase(iterator it)
+    {
+        m_index.erase(std::cref(it->first));
+        return m_tasks.erase(it);
+    }
+
+    size_t erase(const key_type &key)
+    {
+        auto it = m_index.find(std::cref(key));
+        if (it == m_index.end())
+        {
+            return 0;
+        }
+
+        m_tasks.erase(it->second);
+        m_index.erase(it);
+        return 1;
+    }
+
+    /* Move the task before pos, the iterators of all the tasks stay valid */
+    void move(iterator pos, iterator it)
+    {
+        m_tasks.splice(pos, m_tasks, it);
+    }
+
+    void clear()
+    {
+        m_index.clear();
+        m_tasks.clear();
+    }
+
+    /*
+     * Queue a task. A new task, or a DEL task, replaces the pending task of
+     * the key. Otherwise the fields of the task are merged into the pending
+     * task: a field that is already pending is dropped from its position and
+     * the new value is appended, and the operation is taken from the new task.
+     */
+    void merge(mapped_type &&task)
+    {
+        const key_type &key = kfvKey(task);
+
+        auto it = m_index.find(std::cref(key));
+        if (it == m_index.end())
+        {
+            insert(key, std::move(task));
+            return;
+        }
+
+        mapped_type &existing = it->second->second;
+
+        if (kfvOp(task) == DEL_COMMAND)
+        {
+            existing = std::move(task);
+            return;
+        }
+
+        kfvOp(existing) = std::move(kfvOp(task));
+
+        auto &existing_values = kfvFieldsValues(existing);
+        auto &new_values = kfvFieldsValues(task);
+
+        /* Index the new fields by the position of their last value */
+        std::unordered_map<std::string, size_t> field_index;
+        field_index.reserve(new_values.size());
+        for (size_t i = 0; i < new_values.size(); i++)
+        {
+            field_index[fvField(new_values[i])] = i;
+        }
+
+        /* Drop the pending values of the fields that are set again */
+        size_t n = 0;
+        for (size_t i = 0; i < existing_values.size(); i++)
+        {
+            if (field_index.count(fvField(existing_values[i])))
+            {
+                continue;
+            }
+            if (n != i)
+            {
+                existing_values[n] = std::move(existing_values[i]);
+            }
+            n++;
+        }
+        existing_values.resize(n);
+
+        for (size_t i = 0; i < new_values.size(); i++)
+        {
+            if (field_index[fvField(new_values[i])] == i)
+            {
+                existing_values.push_back(std::move(new_values[i]));
+            }
+        }
+    }
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const std::reference_wrapper<const key_type> &key) const
+        {
+            return std::hash<key_type>()(key.get());
+        }
+    };
+
+    struct KeyEqual
+    {
+        bool operator()(const std::reference_wrapper<const key_type> &a,
+                        const std::reference_wrapper<const key_type> &b) const
+        {
+            return a.get() == b.get();
+        }
+    };
+
+    std::list<value_type> m_tasks;
+    std::unordered_map<std::reference_wrapper<const key_type>, iterator, KeyHash, KeyEqual> m_index;
+
+    template <typename V>
+    iterator insert(const key_type &key, V &&task)
+    {
+        auto it = m_tasks.emplace(m_tasks.end(), key, std::forward<V>(task));
+        m_index.emplace(std::cref(it->first), it);
+        return it;
+    }
+};
+
+#endif /* SWSS_SYNCMAP_H */
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "nexthopset.h"
+
+using namespace std;
+using namespace swss;
+
+TEST(NextHopSet, intern)
+{
+    size_t pool_size = NextHopSet::poolSize();
+
+    {
+        NextHopSet a(IpAddresses("10.0.0.1,10.0.0.2"));
+        NextHopSet b(IpAddresses("10.0.0.2,10.0.0.1"));
+        NextHopSet c(IpAddresses("10.0.0.1"));
+
+        EXPECT_EQ(NextHopSet::poolSize(), pool_size + 2);
+        EXPECT_TRUE(a == b);
+        EXPECT_TRUE(a != c);
+        EXPECT_EQ(&*a, &*b);
+        EXPECT_TRUE(a == IpAddresses("10.0.0.1,10.0.0.2"));
+        EXPECT_EQ(a->getSize(), 2u);
+
+        /* One canonical string is shared by the handles of a set */
+        EXPECT_EQ(a.to_string(), IpAddresses("10.0.0.2,10.0.0.1").to_string());
+        EXPECT_EQ(&a.to_string(), &b.to_string());
+        EXPECT_EQ(c.to_string(), "10.0.0.1");
+
+        /* The set is freed with its last handle */
+        c = a;
+        EXPECT_EQ(NextHopSet::poolSize(), pool_size + 1);
+        EXPECT_TRUE(c == b);
+    }
+
+    EXPECT_EQ(NextHopSet::poolSize(), pool_size);
+}
+
+TEST(NextHopSet, empty)
+{
+    size_t pool_size = NextHopSet::poolSize();
+
+    NextHopSet a;
+    NextHopSet b((IpAddresses()));
+
+    EXPECT_TRUE(a == b);
+    EXPECT_EQ(a->getSize(), 0u);
+    EXPECT_TRUE(a == IpAddresses());
+    EXPECT_EQ(a.to_string(), "");
+    EXPECT_EQ(NextHopSet::poolSize(), pool_size);
+}
+
+TEST(NextHopSet, route_table)
+{
+    size_t pool_size = NextHopSet::poolSize();
+    size_t memory = NextHopSet::memoryUsage();
+
+    map<int, NextHopSet> routes;
+    for (int i = 0; i < 10000; i++)
+    {
+        routes[i] = IpAddresses("10.0.0." + to_string(i % 4 + 1) + ",10.0.1.1");
+    }
+
+    EXPECT_EQ(NextHopSet::poolSize(), pool_size + 4);
+    EXPECT_GT(NextHopSet::memoryUsage(), memory);
+
+    for (int i = 0; i < 10000; i += 4)
+    {
+        routes.erase(i);
+    }
+    EXPECT_EQ(NextHopSet::poolSize(), pool_size + 3);
+
+    routes.clear();
+    EXPECT_EQ(NextHopSet::poolSize(), pool_size);
+}
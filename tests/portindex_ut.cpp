@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "portindex.h"
+
+using namespace std;
+using namespace swss;
+
+/* Port lookup by scanning the port list, as PortsOrch did before the index */
+static const Port *scanObject(const map<string, Port> &ports, sai_object_id_t id)
+{
+    for (const auto &it : ports)
+    {
+        if (PortIndex::objectId(it.second) == id)
+        {
+            return &it.second;
+        }
+    }
+    return nullptr;
+}
+
+static const Port *scanBridgePort(const map<string, Port> &ports, sai_object_id_t bridge_port_id)
+{
+    for (const auto &it : ports)
+    {
+        if (it.second.m_bridge_port_id == bridge_port_id)
+        {
+            return &it.second;
+        }
+    }
+    return nullptr;
+}
+
+static void setPort(map<string, Port> &ports, PortIndex &index, const Port &port)
+{
+    auto it = ports.find(port.m_alias);
+    if (it != ports.end())
+    {
+        index.erase(port.m_alias, it->second);
+    }
+    ports[port.m_alias] = port;
+    index.insert(port.m_alias, port);
+}
+
+TEST(PortIndex, lookup)
+{
+    map<string, Port> ports;
+    PortIndex index;
+
+    Port eth0("Ethernet0", Port::PHY);
+    eth0.m_port_id = 0x1000;
+    eth0.m_hif_id = 0x2000;
+    setPort(ports, index, eth0);
+
+    Port lag("PortChannel1", Port::LAG);
+    lag.m_lag_id = 0x3000;
+    setPort(ports, index, lag);
+
+    Port vlan("Vlan10", Port::VLAN);
+    vlan.m_vlan_info.vlan_oid = 0x4000;
+    vlan.m_vlan_info.vlan_id = 10;
+    setPort(ports, index, vlan);
+
+    /* A LAG member carries the LAG id, the LAG id still maps to the LAG */
+    eth0.m_lag_id = lag.m_lag_id;
+    eth0.m_bridge_port_id = 0x5000;
+    setPort(ports, index, eth0);
+
+    ASSERT_NE(index.findObject(0x1000), nullptr);
+    EXPECT_EQ(*index.findObject(0x1000), "Ethernet0");
+    ASSERT_NE(index.findObject(0x3000), nullptr);
+    EXPECT_EQ(*index.findObject(0x3000), "PortChannel1");
+    ASSERT_NE(index.findObject(0x4000), nullptr);
+    EXPECT_EQ(*index.findObject(0x4000), "Vlan10");
+    ASSERT_NE(index.findBridgePort(0x5000), nullptr);
+    EXPECT_EQ(*index.findBridgePort(0x5000), "Ethernet0");
+    ASSERT_NE(index.findHostIf(0x2000), nullptr);
+    EXPECT_EQ(*index.findHostIf(0x2000), "Ethernet0");
+
+    /* Null ids are not indexed */
+    EXPECT_EQ(index.findObject(SAI_NULL_OBJECT_ID), nullptr);
+    EXPECT_EQ(index.findBridgePort(SAI_NULL_OBJECT_ID), nullptr);
+
+    /* The bridge port id moves to another port */
+    eth0.m_bridge_port_id = SAI_NULL_OBJECT_ID;
+    lag.m_bridge_port_id = 0x5000;
+    setPort(ports, index, lag);
+    setPort(ports, index, eth0);
+    ASSERT_NE(index.findBridgePort(0x5000), nullptr);
+    EXPECT_EQ(*index.findBridgePort(0x5000), "PortChannel1");
+
+    index.erase(vlan.m_alias, ports[vlan.m_alias]);
+    ports.erase(vlan.m_alias);
+    EXPECT_EQ(index.findObject(0x4000), nullptr);
+}
+
+/*
+ * Look up the ports of a switch with 4k VLANs by scanning the port list and
+ * through the index, check they agree and report the lookup rates.
+ */
+TEST(PortIndex, scale)
+{
+    map<string, Port> ports;
+    PortIndex index;
+    vector<sai_object_id_t> ids;
+    vector<sai_object_id_t> bridge_port_ids;
+
+    sai_object_id_t oid = 0x1000;
+    for (int i = 0; i < 128; i++)
+    {
+        Port port("Ethernet" + to_string(i * 4), Port::PHY);
+        port.m_port_id = oid++;
+        port.m_hif_id = oid++;
+        port.m_bridge_port_id = oid++;
+        ids.push_back(port.m_port_id);
+        bridge_port_ids.push_back(port.m_bridge_port_id);
+        setPort(ports, index, port);
+    }
+    for (int i = 0; i < 64; i++)
+    {
+        Port lag("PortChannel" + to_string(i), Port::LAG);
+        lag.m_lag_id = oid++;
+        lag.m_bridge_port_id = oid++;
+        ids.push_back(lag.m_lag_id);
+        bridge_port_ids.push_back(lag.m_bridge_port_id);
+        setPort(ports, index, lag);
+    }
+    for (int i = 1; i < 4095; i++)
+    {
+        Port vlan("Vlan" + to_string(i), Port::VLAN);
+        vlan.m_vlan_info.vlan_oid = oid++;
+        vlan.m_vlan_info.vlan_id = (sai_vlan_id_t)i;
+        ids.push_back(vlan.m_vlan_info.vlan_oid);
+        setPort(ports, index, vlan);
+    }
+
+    const size_t lookups = 20000;
+
+    auto start = chrono::steady_clock::now();
+    size_t found = 0;
+    for (size_t i = 0; i < lookups; i++)
+    {
+        found += scanObject(ports, ids[i % ids.size()]) != nullptr;
+        found += scanBridgePort(ports, bridge_port_ids[i % bridge_port_ids.size()]) != nullptr;
+    }
+    auto scan_time = chrono::steady_clock::now() - start;
+    EXPECT_EQ(found, 2 * lookups);
+
+    start = chrono::steady_clock::now();
+    found = 0;
+    for (size_t i = 0; i < lookups; i++)
+    {
+        found += index.findObject(ids[i % ids.size()]) != nullptr;
+        found += index.findBridgePort(bridge_port_ids[i % bridge_port_ids.size()]) != nullptr;
+    }
+    auto time = chrono::steady_clock::now() - start;
+    EXPECT_EQ(found, 2 * lookups);
+
+    for (auto id : ids)
+    {
+        const string *alias = index.findObject(id);
+        ASSERT_NE(alias, nullptr);
+        EXPECT_EQ(*alias, scanObject(ports, id)->m_alias);
+    }
+    for (auto id : bridge_port_ids)
+    {
+        const string *alias = index.findBridgePort(id);
+        ASSERT_NE(alias, nullptr);
+        EXPECT_EQ(*alias, scanBridgePort(ports, id)->m_alias);
+    }
+
+    auto rate = [lookups](chrono::steady_clock::duration d)
+    {
+        auto us = chrono::duration_cast<chrono::microseconds>(d).count();
+        return us ? (long long)(2 * lookups) * 1000000 / us : 0;
+    };
+
+    cout << "Looked up " << 2 * lookups << " ids among " << ports.size() << " ports: "
+         << "scan " << rate(scan_time) << " lookups/s, "
+         << "index " << rate(time) << " lookups/s" << endl;
+}
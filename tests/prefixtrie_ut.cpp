@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "prefixtrie.h"
+
+using namespace std;
+using namespace swss;
+
+typedef PrefixTrie<int>::Key Key;
+
+static Key makeKey(uint32_t bits, size_t len)
+{
+    Key key;
+    key.fill(0);
+    if (len < 32)
+    {
+        bits &= len ? ~0u << (32 - len) : 0u;
+    }
+    key[0] = static_cast<uint8_t>(bits >> 24);
+    key[1] = static_cast<uint8_t>(bits >> 16);
+    key[2] = static_cast<uint8_t>(bits >> 8);
+    key[3] = static_cast<uint8_t>(bits);
+    return key;
+}
+
+static bool covers(uint32_t prefix, size_t len, uint32_t addr)
+{
+    return len == 0 || ((prefix ^ addr) >> (32 - len)) == 0;
+}
+
+template <typename T>
+static vector<T> collectCovering(IpPrefixTrie<T> &trie, const string &addr)
+{
+    vector<T> values;
+    trie.visitCovering(IpAddress(addr), [&](T &value) { values.push_back(value); });
+    return values;
+}
+
+template <typename T>
+static set<T> collectCovered(IpPrefixTrie<T> &trie, const string &prefix)
+{
+    set<T> values;
+    trie.visitCovered(IpPrefix(prefix), [&](T &value) { values.insert(value); });
+    return values;
+}
+
+TEST(PrefixTrie, lpm_v4)
+{
+    IpPrefixTrie<string> routes;
+
+    routes.insert(IpPrefix("0.0.0.0/0"), "default");
+    routes.insert(IpPrefix("10.0.0.0/8"), "10/8");
+    routes.insert(IpPrefix("10.1.0.0/16"), "10.1/16");
+    routes.insert(IpPrefix("10.1.1.0/24"), "10.1.1/24");
+    routes.insert(IpPrefix("10.2.0.0/16"), "10.2/16");
+    routes.insert(IpPrefix("192.168.0.0/16"), "192.168/16");
+    EXPECT_EQ(routes.size(), 6u);
+
+    EXPECT_EQ(collectCovering(routes, "10.1.1.1"), vector<string>({ "default", "10/8", "10.1/16", "10.1.1/24" }));
+    EXPECT_EQ(collectCovering(routes, "10.1.2.1"), vector<string>({ "default", "10/8", "10.1/16" }));
+    EXPECT_EQ(collectCovering(routes, "11.0.0.1"), vector<string>({ "default" }));
+
+    /* Host bits of the prefix are ignored */
+    ASSERT_NE(routes.find(IpPrefix("10.1.1.77/24")), nullptr);
+    EXPECT_EQ(*routes.find(IpPrefix("10.1.1.77/24")), "10.1.1/24");
+    EXPECT_EQ(routes.find(IpPrefix("10.1.0.0/17")), nullptr);
+
+    EXPECT_TRUE(routes.erase(IpPrefix("10.1.0.0/16")));
+    EXPECT_FALSE(routes.erase(IpPrefix("10.1.0.0/16")));
+    EXPECT_EQ(collectCovering(routes, "10.1.1.1"), vector<string>({ "default", "10/8", "10.1.1/24" }));
+    EXPECT_EQ(routes.size(), 5u);
+}
+
+TEST(PrefixTrie, covered)
+{
+    IpPrefixTrie<string> observers;
+
+    observers.insert(IpAddress("10.1.1.1"), "10.1.1.1");
+    observers.insert(IpAddress("10.1.2.1"), "10.1.2.1");
+    observers.insert(IpAddress("20.0.0.1"), "20.0.0.1");
+    observers.insert(IpAddress("2001:db8::1"), "2001:db8::1");
+
+    EXPECT_EQ(collectCovered(observers, "10.1.0.0/16"), set<string>({ "10.1.1.1", "10.1.2.1" }));
+    EXPECT_EQ(collectCovered(observers, "10.1.1.0/24"), set<string>({ "10.1.1.1" }));
+    EXPECT_EQ(collectCovered(observers, "10.1.1.1/32"), set<string>({ "10.1.1.1" }));
+    EXPECT_EQ(collectCovered(observers, "0.0.0.0/0"), set<string>({ "10.1.1.1", "10.1.2.1", "20.0.0.1" }));
+    EXPECT_TRUE(collectCovered(observers, "30.0.0.0/8").empty());
+    EXPECT_EQ(collectCovered(observers, "2001:db8::/32"), set<string>({ "2001:db8::1" }));
+    EXPECT_EQ(collectCovered(observers, "::/0"), set<string>({ "2001:db8::1" }));
+
+    EXPECT_TRUE(observers.erase(IpAddress("10.1.1.1")));
+    EXPECT_EQ(collectCovered(observers, "10.1.0.0/16"), set<string>({ "10.1.2.1" }));
+}
+
+/* Compare the trie against a linear scan of random prefixes */
+TEST(PrefixTrie, random)
+{
+    PrefixTrie<int> trie;
+    map<pair<uint32_t, size_t>, int> prefixes;
+    srand(1);
+
+    for (int i = 0; i < 20000; i++)
+    {
+        /* Keep the prefixes in a small range to get nested prefixes */
+        uint32_t bits = static_cast<uint32_t>(rand() % 4096) << 20 | static_cast<uint32_t>(rand() % 16);
+        size_t len = static_cast<size_t>(rand() % 33);
+        auto id = make_pair(bits & (len ? ~0u << (32 - len) : 0u), len);
+
+        if (rand() % 3 == 0)
+        {
+            EXPECT_EQ(trie.erase(makeKey(bits, len), len), prefixes.erase(id) == 1);
+        }
+        else
+        {
+            trie.insert(makeKey(bits, len), len, i);
+            prefixes[id] = i;
+        }
+    }
+
+    ASSERT_EQ(trie.size(), prefixes.size());
+
+    for (int i = 0; i < 1000; i++)
+    {
+        uint32_t addr = static_cast<uint32_t>(rand() % 4096) << 20 | static_cast<uint32_t>(rand() % 16);
+
+        set<int> expected;
+        for (auto &it : prefixes)
+        {
+            if (covers(it.first.first, it.first.second, addr))
+            {
+                expected.insert(it.second);
+            }
+        }
+
+        set<int> found;
+        trie.visitCovering(makeKey(addr, 32), 32, [&](int &value) { found.insert(value); });
+        EXPECT_EQ(found, expected);
+
+        size_t len = static_cast<size_t>(rand() % 33);
+        uint32_t prefix = addr & (len ? ~0u << (32 - len) : 0u);
+
+        expected.clear();
+        for (auto &it : prefixes)
+        {
+            if (it.first.second >= len && covers(prefix, len, it.first.first))
+            {
+                expected.insert(it.second);
+            }
+        }
+
+        found.clear();
+        trie.visitCovered(makeKey(prefix, len), len, [&](int &value) { found.insert(value); });
+        EXPECT_EQ(found, expected);
+    }
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "retrycache.h"
+
+using namespace std;
+using namespace swss;
+
+static void park(RetryCache &cache, SyncMap &toSync, const string &key, const Constraint &cst)
+{
+    auto it = toSync.find(key);
+    ASSERT_NE(it, toSync.end());
+    cache.insert(cst, move(it->second));
+    toSync.erase(it);
+}
+
+TEST(RetryCache, resolve)
+{
+    SyncMap toSync;
+    RetryCache cache;
+
+    toSync.merge(KeyOpFieldsValuesTuple("1.1.1.0/24", SET_COMMAND, { { "nexthop", "10.0.0.1" } }));
+    toSync.merge(KeyOpFieldsValuesTuple("2.2.2.0/24", SET_COMMAND, { { "nexthop", "10.0.0.3" } }));
+
+    park(cache, toSync, "1.1.1.0/24", Constraint(RETRY_CST_NEXTHOP, "10.0.0.1"));
+    park(cache, toSync, "2.2.2.0/24", Constraint(RETRY_CST_NEXTHOP, "10.0.0.3"));
+    EXPECT_TRUE(toSync.empty());
+    EXPECT_EQ(cache.size(), 2u);
+
+    /* Constraints of other types or names do not re-queue the tasks */
+    RetryCache::resolveAll(Constraint(RETRY_CST_PORT_READY, "10.0.0.1"));
+    RetryCache::resolveAll(Constraint(RETRY_CST_NEXTHOP, "10.0.0.5"));
+    EXPECT_FALSE(cache.hasResolved());
+    cache.restoreResolved(toSync);
+    EXPECT_TRUE(toSync.empty());
+
+    RetryCache::resolveAll(Constraint(RETRY_CST_NEXTHOP, "10.0.0.1"));
+    EXPECT_TRUE(cache.hasResolved());
+    EXPECT_EQ(cache.restoreResolved(toSync), vector<string>{ "1.1.1.0/24" });
+    EXPECT_FALSE(cache.hasResolved());
+    EXPECT_EQ(toSync.size(), 1u);
+    EXPECT_EQ(toSync.count("1.1.1.0/24"), 1u);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(RetryCache, restore_before_new_task)
+{
+    SyncMap toSync;
+    RetryCache cache;
+
+    toSync.merge(KeyOpFieldsValuesTuple("Ethernet0", SET_COMMAND, { { "mtu", "9100" }, { "speed", "40000" } }));
+    park(cache, toSync, "Ethernet0", Constraint(RETRY_CST_PORT_READY, "Ethernet0"));
+
+    /* The parked task is merged ahead of the new task of the same key */
+    cache.restore("Ethernet0", toSync);
+    toSync.merge(KeyOpFieldsValuesTuple("Ethernet0", SET_COMMAND, { { "mtu", "1500" } }));
+
+    EXPECT_TRUE(cache.empty());
+    vector<FieldValueTuple> expected = { { "speed", "40000" }, { "mtu", "1500" } };
+    EXPECT_EQ(kfvFieldsValues(toSync["Ethernet0"]), expected);
+
+    /* A pending task queued meanwhile stays newer than the parked one */
+    park(cache, toSync, "Ethernet0", Constraint(RETRY_CST_PORT_READY, "Ethernet0"));
+    toSync["Ethernet0"] = KeyOpFieldsValuesTuple("Ethernet0", DEL_COMMAND, { });
+
+    RetryCache::resolveAll(Constraint(RETRY_CST_PORT_READY, "Ethernet0"));
+    cache.restoreResolved(toSync);
+    EXPECT_EQ(kfvOp(toSync["Ethernet0"]), DEL_COMMAND);
+}
+
+TEST(RetryCache, contains)
+{
+    SyncMap toSync;
+    RetryCache cache;
+
+    toSync.merge(KeyOpFieldsValuesTuple("1.1.1.0/24", SET_COMMAND, { { "nexthop", "10.0.0.1" } }));
+    EXPECT_FALSE(cache.contains("1.1.1.0/24"));
+
+    park(cache, toSync, "1.1.1.0/24", Constraint(RETRY_CST_NEXTHOP, "10.0.0.1"));
+    EXPECT_TRUE(cache.contains("1.1.1.0/24"));
+    EXPECT_FALSE(cache.contains("2.2.2.0/24"));
+
+    cache.restore("1.1.1.0/24", toSync);
+    EXPECT_FALSE(cache.contains("1.1.1.0/24"));
+}
+
+TEST(RetryCache, resolve_all_consumers)
+{
+    SyncMap queueToSync, pgToSync;
+    RetryCache queueCache, pgCache;
+
+    queueToSync.merge(KeyOpFieldsValuesTuple("Ethernet0|3-4", SET_COMMAND, { { "profile", "[BUFFER_PROFILE|lossless]" } }));
+    pgToSync.merge(KeyOpFieldsValuesTuple("Ethernet0|3-4", SET_COMMAND, { { "profile", "[BUFFER_PROFILE|lossless]" } }));
+    park(queueCache, queueToSync, "Ethernet0|3-4", Constraint(RETRY_CST_BUFFER_PROFILE, "lossless"));
+    park(pgCache, pgToSync, "Ethernet0|3-4", Constraint(RETRY_CST_BUFFER_PROFILE, "lossless"));
+
+    /* One profile creation re-queues the tasks of every consumer waiting for it */
+    RetryCache::resolveAll(Constraint(RETRY_CST_BUFFER_PROFILE, "lossless"));
+    EXPECT_TRUE(queueCache.hasResolved());
+    EXPECT_TRUE(pgCache.hasResolved());
+
+    queueCache.restoreResolved(queueToSync);
+    pgCache.restoreResolved(pgToSync);
+    EXPECT_EQ(queueToSync.count("Ethernet0|3-4"), 1u);
+    EXPECT_EQ(pgToSync.count("Ethernet0|3-4"), 1u);
+    EXPECT_TRUE(queueCache.empty());
+    EXPECT_TRUE(pgCache.empty());
+}
+
+TEST(RetryCache, take_resolved)
+{
+    SyncMap toSync;
+    RetryCache cache, other;
+
+    RetryCache::takeResolved();
+
+    toSync.merge(KeyOpFieldsValuesTuple("1.1.1.0/24", SET_COMMAND, { { "nexthop", "10.0.0.1" } }));
+    toSync.merge(KeyOpFieldsValuesTuple("2.2.2.0/24", SET_COMMAND, { { "nexthop", "10.0.0.2" } }));
+    park(cache, toSync, "1.1.1.0/24", Constraint(RETRY_CST_NEXTHOP, "10.0.0.1"));
+    park(cache, toSync, "2.2.2.0/24", Constraint(RETRY_CST_NEXTHOP, "10.0.0.2"));
+
+    /* Only the caches with resolved tasks are reported, once each */
+    RetryCache::resolveAll(Constraint(RETRY_CST_NEXTHOP, "10.0.0.1"));
+    RetryCache::resolveAll(Constraint(RETRY_CST_NEXTHOP, "10.0.0.2"));
+    EXPECT_EQ(RetryCache::takeResolved(), vector<RetryCache *>{ &cache });
+    EXPECT_TRUE(RetryCache::takeResolved().empty());
+
+    {
+        RetryCache gone;
+        toSync.merge(KeyOpFieldsValuesTuple("3.3.3.0/24", SET_COMMAND, { { "nexthop", "10.0.0.3" } }));
+        park(gone, toSync, "3.3.3.0/24", Constraint(RETRY_CST_NEXTHOP, "10.0.0.3"));
+        RetryCache::resolveAll(Constraint(RETRY_CST_NEXTHOP, "10.0.0.3"));
+    }
+    EXPECT_TRUE(RetryCache::takeResolved().empty());
+}
@@ -0,0 +1,288 @@
+#include <gtest/gtest.h>
+#include <netlink/msg.h>
+#include <netlink/route/route.h>
+#include <netlink/route/nexthop.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "fpmsyncd/fpm/fpm.h"
+#include "fpmsyncd/rtnlroute.h"
+#include "fpmsyncd/fpmroutewriter.h"
+
+using namespace std;
+using namespace swss;
+
+#define ADDR_SIZE 64
+
+/* Route as formatted by fpmsyncd: prefix, then gateway@ifindex of each next hop */
+struct FormattedRoute
+{
+    int family;
+    int type;
+    string prefix;
+    vector<string> nexthops;
+};
+
+static FormattedRoute decodeDirect(struct nlmsghdr *h, RtnlRoute &route)
+{
+    FormattedRoute out;
+    char buf[ADDR_SIZE + 1];
+
+    EXPECT_TRUE(parseRtnlRoute(h, route));
+
+    out.family = route.family;
+    out.type = route.type;
+    out.prefix = formatRtnlAddr(route.family, route.dst, route.dst_len, buf, sizeof(buf));
+
+    unsigned char addr_len = (unsigned char)(8 * rtnlAddrSize(route.family));
+    for (auto &nh : route.nexthops)
+    {
+        string gateway = nh.gateway ? formatRtnlAddr(route.family, nh.gateway, addr_len, buf, sizeof(buf)) : "";
+        out.nexthops.push_back(gateway + "@" + to_string(nh.ifindex));
+    }
+
+    return out;
+}
+
+static void parseLibnlRoute(struct nl_object *obj, void *arg)
+{
+    struct rtnl_route *route_obj = (struct rtnl_route *)obj;
+    FormattedRoute &out = *(FormattedRoute *)arg;
+    char buf[ADDR_SIZE + 1] = {0};
+
+    out.family = rtnl_route_get_family(route_obj);
+    out.type = rtnl_route_get_type(route_obj);
+    out.prefix = nl_addr2str(rtnl_route_get_dst(route_obj), buf, ADDR_SIZE);
+
+    for (int i = 0; i < rtnl_route_get_nnexthops(route_obj); i++)
+    {
+        struct rtnl_nexthop *nexthop = rtnl_route_nexthop_n(route_obj, i);
+        struct nl_addr *addr = rtnl_route_nh_get_gateway(nexthop);
+        string gateway = addr ? nl_addr2str(addr, buf, ADDR_SIZE) : "";
+        out.nexthops.push_back(gateway + "@" + to_string(rtnl_route_nh_get_ifindex(nexthop)));
+    }
+}
+
+/* Decode the message as fpmsyncd did through libnl */
+static FormattedRoute decodeLibnl(struct nlmsghdr *h)
+{
+    FormattedRoute out;
+
+    nl_msg *msg = nlmsg_convert(h);
+    EXPECT_NE(msg, nullptr);
+    nlmsg_set_proto(msg, NETLINK_ROUTE);
+    nl_msg_parse(msg, parseLibnlRoute, &out);
+    nlmsg_free(msg);
+
+    return out;
+}
+
+/* Call the visitor with each netlink message of the FPM stream */
+template <typename F>
+static size_t forEachMessage(vector<char> &stream, F visit)
+{
+    size_t count = 0;
+    size_t start = 0;
+
+    while (stream.size() - start >= FPM_MSG_HDR_LEN)
+    {
+        fpm_msg_hdr_t *hdr = (fpm_msg_hdr_t *)&stream[start];
+        size_t msg_len = fpm_msg_len(hdr);
+        if (msg_len < FPM_MSG_HDR_LEN || stream.size() - start < msg_len)
+        {
+            break;
+        }
+
+        struct nlmsghdr *h = (struct nlmsghdr *)fpm_msg_data(hdr);
+        if (hdr->msg_type == FPM_MSG_TYPE_NETLINK &&
+            (h->nlmsg_type == RTM_NEWROUTE || h->nlmsg_type == RTM_DELROUTE))
+        {
+            visit(h);
+            count++;
+        }
+
+        start += msg_len;
+    }
+
+    return count;
+}
+
+static void generateRoutes(FpmRouteWriter &writer, size_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t dst = htonl(0x0a000000 | i << 8);
+        writer.begin(RTM_NEWROUTE, AF_INET, RTN_UNICAST, 24);
+        writer.addAttr(RTA_DST, &dst, sizeof(dst));
+
+        if (i % 2)
+        {
+            uint32_t gw = htonl(0xc0a80001 + i % 32);
+            int oif = (int)(i % 32 + 1);
+            writer.addAttr(RTA_GATEWAY, &gw, sizeof(gw));
+            writer.addAttr(RTA_OIF, &oif, sizeof(oif));
+        }
+        else
+        {
+            uint32_t gws[4];
+            vector<pair<const void *, int>> nexthops;
+            for (uint32_t j = 0; j < 4; j++)
+            {
+                gws[j] = htonl(0xc0a80001 + j);
+                nexthops.emplace_back(&gws[j], (int)(j + 1));
+            }
+            writer.addMultipath(nexthops, sizeof(uint32_t));
+        }
+
+        writer.end();
+    }
+}
+
+static void expectSameRoute(const FormattedRoute &a, const FormattedRoute &b)
+{
+    EXPECT_EQ(a.family, b.family);
+    EXPECT_EQ(a.type, b.type);
+    EXPECT_EQ(a.prefix, b.prefix);
+    EXPECT_EQ(a.nexthops, b.nexthops);
+}
+
+TEST(RtnlRoute, decode)
+{
+    FpmRouteWriter writer;
+
+    /* IPv4 route with one next hop */
+    uint32_t dst4 = htonl(0x0a010100);
+    uint32_t gw4 = htonl(0x0a000001);
+    int oif = 5;
+    writer.begin(RTM_NEWROUTE, AF_INET, RTN_UNICAST, 24);
+    writer.addAttr(RTA_DST, &dst4, sizeof(dst4));
+    writer.addAttr(RTA_GATEWAY, &gw4, sizeof(gw4));
+    writer.addAttr(RTA_OIF, &oif, sizeof(oif));
+    writer.end();
+
+    /* IPv4 host route */
+    writer.begin(RTM_NEWROUTE, AF_INET, RTN_UNICAST, 32);
+    writer.addAttr(RTA_DST, &dst4, sizeof(dst4));
+    writer.addAttr(RTA_OIF, &oif, sizeof(oif));
+    writer.end();
+
+    /* IPv4 default route removal */
+    uint32_t any4 = 0;
+    writer.begin(RTM_DELROUTE, AF_INET, RTN_UNICAST, 0);
+    writer.addAttr(RTA_DST, &any4, sizeof(any4));
+    writer.end();
+
+    /* IPv6 ECMP route, one next hop without gateway */
+    struct in6_addr dst6, gw6a, gw6b;
+    inet_pton(AF_INET6, "2001:db8:1::", &dst6);
+    inet_pton(AF_INET6, "fe80::1", &gw6a);
+    inet_pton(AF_INET6, "fe80::2", &gw6b);
+    writer.begin(RTM_NEWROUTE, AF_INET6, RTN_UNICAST, 64);
+    writer.addAttr(RTA_DST, &dst6, sizeof(dst6));
+    writer.addMultipath({ { &gw6a, 3 }, { &gw6b, 4 }, { nullptr, 6 } }, sizeof(struct in6_addr));
+    writer.end();
+
+    /* Blackhole route */
+    writer.begin(RTM_NEWROUTE, AF_INET6, RTN_BLACKHOLE, 48);
+    writer.addAttr(RTA_DST, &dst6, sizeof(dst6));
+    writer.end();
+
+    RtnlRoute route;
+    size_t count = forEachMessage(writer.stream(), [&](struct nlmsghdr *h)
+    {
+        expectSameRoute(decodeDirect(h, route), decodeLibnl(h));
+    });
+    EXPECT_EQ(count, 5u);
+
+    forEachMessage(writer.stream(), [&](struct nlmsghdr *h)
+    {
+        FormattedRoute out = decodeDirect(h, route);
+        if (out.family == AF_INET6 && out.type == RTN_UNICAST)
+        {
+            EXPECT_EQ(out.prefix, "2001:db8:1::/64");
+            EXPECT_EQ(out.nexthops, vector<string>({ "fe80::1@3", "fe80::2@4", "@6" }));
+        }
+    });
+}
+
+TEST(RtnlRoute, malformed)
+{
+    FpmRouteWriter writer;
+    RtnlRoute route;
+
+    /* IPv4 route with an IPv6 sized destination */
+    struct in6_addr dst6;
+    inet_pton(AF_INET6, "2001:db8:1::", &dst6);
+    writer.begin(RTM_NEWROUTE, AF_INET, RTN_UNICAST, 24);
+    writer.addAttr(RTA_DST, &dst6, sizeof(dst6));
+    writer.end();
+
+    forEachMessage(writer.stream(), [&](struct nlmsghdr *h)
+    {
+        EXPECT_FALSE(parseRtnlRoute(h, route));
+
+        h->nlmsg_len = NLMSG_LENGTH(0);
+        EXPECT_FALSE(parseRtnlRoute(h, route));
+    });
+}
+
+/*
+ * Decode an FPM stream with both decoders, compare the routes and report the
+ * decoding rate. The stream is read from the capture file given by
+ * FPM_CAPTURE_FILE, or generated when it is not set.
+ */
+TEST(RtnlRoute, replay_stream)
+{
+    FpmRouteWriter writer;
+
+    const char *capture_file = getenv("FPM_CAPTURE_FILE");
+    if (capture_file)
+    {
+        ifstream ifs(capture_file, ios::binary);
+        ASSERT_TRUE(ifs.is_open());
+        writer.stream().assign(istreambuf_iterator<char>(ifs), istreambuf_iterator<char>());
+    }
+    else
+    {
+        generateRoutes(writer, 100000);
+    }
+
+    vector<FormattedRoute> libnl_routes;
+    auto start = chrono::steady_clock::now();
+    size_t count = forEachMessage(writer.stream(), [&](struct nlmsghdr *h)
+    {
+        libnl_routes.push_back(decodeLibnl(h));
+    });
+    auto libnl_time = chrono::steady_clock::now() - start;
+
+    vector<FormattedRoute> routes;
+    routes.reserve(count);
+    RtnlRoute route;
+    start = chrono::steady_clock::now();
+    forEachMessage(writer.stream(), [&](struct nlmsghdr *h)
+    {
+        routes.push_back(decodeDirect(h, route));
+    });
+    auto time = chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(routes.size(), libnl_routes.size());
+    for (size_t i = 0; i < routes.size(); i++)
+    {
+        expectSameRoute(routes[i], libnl_routes[i]);
+    }
+
+    auto rate = [count](chrono::steady_clock::duration d)
+    {
+        auto us = chrono::duration_cast<chrono::microseconds>(d).count();
+        return us ? (long long)count * 1000000 / us : 0;
+    };
+
+    cout << "Decoded " << count << " routes: "
+         << "libnl " << rate(libnl_time) << " routes/s, "
+         << "in place " << rate(time) << " routes/s" << endl;
+}
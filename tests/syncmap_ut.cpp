@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "syncmap.h"
+
+using namespace std;
+using namespace swss;
+
+/* The std::map based task merge that SyncMap replaces, used as the reference */
+typedef map<string, KeyOpFieldsValuesTuple> LegacySyncMap;
+
+static void legacyMerge(LegacySyncMap &m_toSync, const KeyOpFieldsValuesTuple &entry)
+{
+    string key = kfvKey(entry);
+    string op  = kfvOp(entry);
+
+    if (m_toSync.find(key) == m_toSync.end() || op == DEL_COMMAND)
+    {
+       m_toSync[key] = entry;
+    }
+    else
+    {
+        KeyOpFieldsValuesTuple existing_data = m_toSync[key];
+
+        auto new_values = kfvFieldsValues(entry);
+        auto existing_values = kfvFieldsValues(existing_data);
+
+        for (auto it : new_values)
+        {
+            string field = fvField(it);
+            string value = fvValue(it);
+
+            auto iu = existing_values.begin();
+            while (iu != existing_values.end())
+            {
+                string ofield = fvField(*iu);
+                if (field == ofield)
+                    iu = existing_values.erase(iu);
+                else
+                    iu++;
+            }
+            existing_values.push_back(FieldValueTuple(field, value));
+        }
+        m_toSync[key] = KeyOpFieldsValuesTuple(key, op, existing_values);
+    }
+}
+
+static void expectSameTasks(LegacySyncMap &legacy, SyncMap &tasks)
+{
+    ASSERT_EQ(legacy.size(), tasks.size());
+
+    for (auto &it : legacy)
+    {
+        auto task = tasks.find(it.first);
+        ASSERT_NE(task, tasks.end());
+        EXPECT_EQ(kfvOp(it.second), kfvOp(task->second));
+        EXPECT_EQ(kfvFieldsValues(it.second), kfvFieldsValues(task->second));
+    }
+}
+
+/* Parse a swss.rec line: timestamp|table:key|op|field:value|... */
+static bool parseRecord(const string &line, KeyOpFieldsValuesTuple &entry)
+{
+    vector<string> tokens;
+    size_t start = 0;
+    size_t pos;
+    while ((pos = line.find('|', start)) != string::npos)
+    {
+        tokens.push_back(line.substr(start, pos - start));
+        start = pos + 1;
+    }
+    tokens.push_back(line.substr(start));
+
+    if (tokens.size() < 3 || tokens[1].find(':') == string::npos)
+    {
+        return false;
+    }
+
+    vector<FieldValueTuple> values;
+    for (size_t i = 3; i < tokens.size(); i++)
+    {
+        size_t sep = tokens[i].find(':');
+        if (sep == string::npos)
+        {
+            return false;
+        }
+        values.emplace_back(tokens[i].substr(0, sep), tokens[i].substr(sep + 1));
+    }
+
+    /* Keep the table name in the key to keep the tables apart */
+    entry = KeyOpFieldsValuesTuple(tokens[1], tokens[2], values);
+    return true;
+}
+
+static vector<KeyOpFieldsValuesTuple> generateTrace(size_t keys, size_t updates)
+{
+    vector<KeyOpFieldsValuesTuple> trace;
+    srand(1);
+
+    for (size_t i = 0; i < updates; i++)
+    {
+        string key = "ROUTE_TABLE:10." + to_string(i % keys / 256) + "." + to_string(i % keys % 256) + ".0/24";
+        if (rand() % 10 == 0)
+        {
+            trace.emplace_back(key, DEL_COMMAND, vector<FieldValueTuple>());
+            continue;
+        }
+
+        vector<FieldValueTuple> values;
+        values.emplace_back("nexthop", "10.0.0." + to_string(rand() % 64));
+        values.emplace_back("ifname", "Ethernet" + to_string(rand() % 32 * 4));
+        if (rand() % 2)
+        {
+            values.emplace_back("blackhole", rand() % 2 ? "true" : "false");
+        }
+        trace.emplace_back(key, SET_COMMAND, values);
+    }
+
+    return trace;
+}
+
+TEST(SyncMap, merge)
+{
+    SyncMap tasks;
+
+    tasks.merge(KeyOpFieldsValuesTuple("k", SET_COMMAND, { { "a", "1" }, { "b", "2" }, { "c", "3" } }));
+    tasks.merge(KeyOpFieldsValuesTuple("k", SET_COMMAND, { { "b", "4" }, { "d", "5" }, { "b", "6" } }));
+
+    ASSERT_EQ(tasks.size(), 1u);
+    vector<FieldValueTuple> expected = { { "a", "1" }, { "c", "3" }, { "d", "5" }, { "b", "6" } };
+    EXPECT_EQ(kfvFieldsValues(tasks["k"]), expected);
+
+    tasks.merge(KeyOpFieldsValuesTuple("k", DEL_COMMAND, { }));
+    EXPECT_EQ(kfvOp(tasks["k"]), DEL_COMMAND);
+    EXPECT_TRUE(kfvFieldsValues(tasks["k"]).empty());
+
+    tasks.merge(KeyOpFieldsValuesTuple("k", SET_COMMAND, { { "a", "7" } }));
+    EXPECT_EQ(kfvOp(tasks["k"]), SET_COMMAND);
+    EXPECT_EQ(kfvFieldsValues(tasks["k"]).size(), 1u);
+}
+
+TEST(SyncMap, iteration_order_and_erase)
+{
+    SyncMap tasks;
+
+    tasks.merge(KeyOpFieldsValuesTuple("c", SET_COMMAND, { }));
+    tasks.merge(KeyOpFieldsValuesTuple("a", SET_COMMAND, { }));
+    tasks.merge(KeyOpFieldsValuesTuple("b", SET_COMMAND, { }));
+    tasks.merge(KeyOpFieldsValuesTuple("c", DEL_COMMAND, { }));
+
+    vector<string> keys;
+    for (auto &it : tasks)
+    {
+        keys.push_back(it.first);
+    }
+    EXPECT_EQ(keys, vector<string>({ "c", "a", "b" }));
+
+    auto it = tasks.begin();
+    while (it != tasks.end())
+    {
+        if (it->first == "a")
+            it = tasks.erase(it);
+        else
+            it++;
+    }
+    EXPECT_EQ(tasks.size(), 2u);
+    EXPECT_EQ(tasks.find("a"), tasks.end());
+    EXPECT_EQ(tasks.count("b"), 1u);
+
+    EXPECT_EQ(tasks.erase("c"), 1u);
+    EXPECT_EQ(tasks.erase("c"), 0u);
+    EXPECT_EQ(tasks.begin()->first, "b");
+}
+
+TEST(SyncMap, move)
+{
+    SyncMap tasks;
+
+    tasks.merge(KeyOpFieldsValuesTuple("a", SET_COMMAND, { }));
+    tasks.merge(KeyOpFieldsValuesTuple("b", SET_COMMAND, { }));
+    tasks.merge(KeyOpFieldsValuesTuple("c", SET_COMMAND, { }));
+
+    auto c = tasks.find("c");
+    tasks.move(tasks.begin(), c);
+    tasks.move(tasks.end(), tasks.find("a"));
+
+    vector<string> keys;
+    for (auto &it : tasks)
+    {
+        keys.push_back(it.first);
+    }
+    EXPECT_EQ(keys, vector<string>({ "c", "b", "a" }));
+
+    /* The index still finds the moved tasks */
+    EXPECT_EQ(tasks.find("c"), c);
+    EXPECT_EQ(tasks.erase("a"), 1u);
+    EXPECT_EQ(tasks.size(), 2u);
+}
+
+/*
+ * Replay a trace into both SyncMap and the std::map based merge, compare the
+ * resulting tasks and report the time spent. The trace is read from the
+ * swss.rec file given by SWSS_REC_FILE, or generated when it is not set.
+ */
+TEST(SyncMap, replay_trace)
+{
+    vector<KeyOpFieldsValuesTuple> trace;
+
+    const char *rec_file = getenv("SWSS_REC_FILE");
+    if (rec_file)
+    {
+        ifstream ifs(rec_file);
+        ASSERT_TRUE(ifs.is_open());
+
+        string line;
+        KeyOpFieldsValuesTuple entry;
+        while (getline(ifs, line))
+        {
+            if (parseRecord(line, entry))
+            {
+                trace.push_back(entry);
+            }
+        }
+    }
+    else
+    {
+        trace = generateTrace(20000, 200000);
+    }
+
+    LegacySyncMap legacy;
+    auto start = chrono::steady_clock::now();
+    for (auto &entry : trace)
+    {
+        legacyMerge(legacy, entry);
+    }
+    auto legacy_time = chrono::steady_clock::now() - start;
+
+    vector<KeyOpFieldsValuesTuple> entries(trace);
+    SyncMap tasks;
+    start = chrono::steady_clock::now();
+    for (auto &entry : entries)
+    {
+        tasks.merge(move(entry));
+    }
+    auto time = chrono::steady_clock::now() - start;
+
+    expectSameTasks(legacy, tasks);
+
+    cout << "Replayed " << trace.size() << " tasks into " << tasks.size() << " keys: "
+         << "std::map " << chrono::duration_cast<chrono::milliseconds>(legacy_time).count() << "ms, "
+         << "SyncMap " << chrono::duration_cast<chrono::milliseconds>(time).count() << "ms" << endl;
+}
@@ -0,0 +1,45 @@
+from swsscommon import swsscommon
+import time
+
+
+def get_pgs_with_profile(adb):
+    asic_pg_table = swsscommon.Table(adb, "ASIC_STATE:SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP")
+
+    count = 0
+    for key in asic_pg_table.getKeys():
+        (status, fvs) = asic_pg_table.get(key)
+        assert status == True
+        for fv in fvs:
+            if fv[0] == "SAI_INGRESS_PRIORITY_GROUP_ATTR_BUFFER_PROFILE" and fv[1] != "oid:0x0":
+                count += 1
+    return count
+
+
+class TestBuffer(object):
+    def test_PgPastMissingProfile(self, dvs):
+        cdb = swsscommon.DBConnector(4, dvs.redis_sock, 0)
+        adb = swsscommon.DBConnector(1, dvs.redis_sock, 0)
+        cfg_buffer_profile_table = swsscommon.Table(cdb, "BUFFER_PROFILE")
+        cfg_buffer_pg_table = swsscommon.Table(cdb, "BUFFER_PG")
+
+        base = get_pgs_with_profile(adb)
+
+        # the first PG waits for its profile, the second one is applied
+        fvs = swsscommon.FieldValuePairs([("profile", "[BUFFER_PROFILE|test_pg_profile]")])
+        cfg_buffer_pg_table.set("Ethernet0|6", fvs)
+        fvs = swsscommon.FieldValuePairs([("profile", "[BUFFER_PROFILE|ingress_lossy_profile]")])
+        cfg_buffer_pg_table.set("Ethernet4|6", fvs)
+        time.sleep(2)
+
+        assert get_pgs_with_profile(adb) == base + 1
+
+        # the first PG is applied once its profile is created
+        (status, fvs) = cfg_buffer_profile_table.get("ingress_lossy_profile")
+        assert status == True
+        cfg_buffer_profile_table.set("test_pg_profile", swsscommon.FieldValuePairs(list(fvs)))
+        time.sleep(2)
+
+        assert get_pgs_with_profile(adb) == base + 2
+
+        cfg_buffer_pg_table._del("Ethernet0|6")
+        cfg_buffer_pg_table._del("Ethernet4|6")
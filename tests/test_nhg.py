@@ -126,3 +126,58 @@ def test_route_nhg(dvs):
             for v in fvs:
                 if v[0] == "SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID":
                     assert v[1] == nhgid
+
+def test_route_nhg_convergence(dvs):
+
+    dvs.runcmd("ifconfig Ethernet12 10.0.1.0/24 up")
+    dvs.runcmd("ifconfig Ethernet16 10.0.2.0/24 up")
+
+    # next hops 10.0.1.x on Ethernet12 and 10.0.2.x on Ethernet16
+    count = 8
+    for i in range(1, count + 1):
+        dvs.runcmd("arp -s 10.0.1.%d 00:00:00:00:01:%02x" % (i, i))
+        dvs.runcmd("arp -s 10.0.2.%d 00:00:00:00:02:%02x" % (i, i))
+
+    dvs.servers[3].runcmd("ip link set up dev eth0") == 0
+    dvs.servers[4].runcmd("ip link set up dev eth0") == 0
+
+    time.sleep(1)
+
+    db = swsscommon.DBConnector(0, dvs.redis_sock, 0)
+    ps = swsscommon.ProducerStateTable(db, "ROUTE_TABLE")
+
+    adb = swsscommon.DBConnector(1, dvs.redis_sock, 0)
+    nhg_member_tbl = swsscommon.Table(adb, "ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER")
+
+    def wait_members(expected, timeout=30):
+        start = time.time()
+        while time.time() - start < timeout:
+            if len(nhg_member_tbl.getKeys()) == expected:
+                return time.time() - start
+            time.sleep(0.01)
+        assert len(nhg_member_tbl.getKeys()) == expected
+
+    groups = count * count
+    base = len(nhg_member_tbl.getKeys())
+
+    # one next hop group per pair of next hops across the two interfaces
+    for i in range(1, count + 1):
+        for j in range(1, count + 1):
+            fvs = swsscommon.FieldValuePairs([("nexthop", "10.0.1.%d,10.0.2.%d" % (i, j)),
+                                              ("ifname", "Ethernet12,Ethernet16")])
+            ps.set("3.%d.%d.0/24" % (i, j), fvs)
+
+    wait_members(base + 2 * groups)
+
+    # measure the time for all the groups to fail over and recover
+    dvs.servers[3].runcmd("ip link set down dev eth0") == 0
+    down = wait_members(base + groups)
+
+    dvs.servers[3].runcmd("ip link set up dev eth0") == 0
+    up = wait_members(base + 2 * groups)
+
+    print("%d groups: failover %.3fs, recovery %.3fs" % (groups, down, up))
+
+    for i in range(1, count + 1):
+        for j in range(1, count + 1):
+            ps._del("3.%d.%d.0/24" % (i, j))
@@ -42,3 +42,51 @@ def test_RouteAdd(dvs):
             found_route = True
 
     assert found_route
+
+def test_RouteAddRemoveBulk(dvs):
+
+    dvs.runcmd("ifconfig Ethernet0 10.0.0.0/31 up")
+    dvs.runcmd("ifconfig Ethernet4 10.0.0.2/31 up")
+
+    dvs.servers[0].runcmd("ifconfig eth0 10.0.0.1/31")
+    dvs.servers[0].runcmd("ip route add default via 10.0.0.0")
+
+    dvs.servers[1].runcmd("ifconfig eth0 10.0.0.3/31")
+    dvs.servers[1].runcmd("ip route add default via 10.0.0.2")
+
+    # get neighbor and arp entry
+    dvs.servers[0].runcmd("ping -c 1 10.0.0.3")
+
+    db = swsscommon.DBConnector(0, dvs.redis_sock, 0)
+    ps = swsscommon.ProducerStateTable(db, "ROUTE_TABLE")
+
+    prefixes = ["3.3.%d.0/24" % i for i in range(200)]
+
+    # add routes in one batch so that they are programmed by bulk calls
+    for prefix in prefixes:
+        fvs = swsscommon.FieldValuePairs([("nexthop","10.0.0.1"), ("ifname", "Ethernet0")])
+        ps.set(prefix, fvs)
+
+    time.sleep(2)
+
+    # check if all routes were propagated to ASIC DB
+
+    adb = swsscommon.DBConnector(1, dvs.redis_sock, 0)
+
+    tbl = swsscommon.Table(adb, "ASIC_STATE:SAI_OBJECT_TYPE_ROUTE_ENTRY")
+
+    routes = set([json.loads(k)['dest'] for k in tbl.getKeys()])
+
+    for prefix in prefixes:
+        assert prefix in routes
+
+    # remove routes in one batch
+    for prefix in prefixes:
+        ps._del(prefix)
+
+    time.sleep(2)
+
+    routes = set([json.loads(k)['dest'] for k in tbl.getKeys()])
+
+    for prefix in prefixes:
+        assert prefix not in routes
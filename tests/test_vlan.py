@@ -91,3 +91,52 @@ def test_VlanMemberCreation(dvs):
     for fv in fvs:
         if fv[0] == "SAI_HOSTIF_ATTR_VLAN_TAG":
             assert fv[1] == "SAI_HOSTIF_VLAN_TAG_KEEP"
+
+def test_VlanMemberScale(dvs):
+
+    db = swsscommon.DBConnector(4, dvs.redis_sock, 0)
+    adb = swsscommon.DBConnector(1, dvs.redis_sock, 0)
+
+    vlan_tbl = swsscommon.Table(db, "VLAN")
+    member_tbl = swsscommon.Table(db, "VLAN_MEMBER")
+    atbl = swsscommon.Table(adb, "ASIC_STATE:SAI_OBJECT_TYPE_VLAN_MEMBER")
+
+    def wait_members(expected, timeout=60):
+        start = time.time()
+        while time.time() - start < timeout:
+            if len(atbl.getKeys()) == expected:
+                return time.time() - start
+            time.sleep(0.01)
+        assert len(atbl.getKeys()) == expected
+
+    vlans = range(100, 164)
+    ports = ["Ethernet%d" % (i * 4) for i in range(8, 16)]
+    members = len(vlans) * len(ports)
+    base = len(atbl.getKeys())
+
+    for vlan in vlans:
+        vlan_tbl.set("Vlan%d" % vlan, swsscommon.FieldValuePairs([("vlanid", str(vlan))]))
+
+    time.sleep(2)
+
+    # trunk ports joining all the vlans
+    for vlan in vlans:
+        for port in ports:
+            fvs = swsscommon.FieldValuePairs([("tagging_mode", "tagged")])
+            member_tbl.set("Vlan%d|%s" % (vlan, port), fvs)
+
+    add = wait_members(base + members)
+
+    for vlan in vlans:
+        for port in ports:
+            member_tbl._del("Vlan%d|%s" % (vlan, port))
+
+    remove = wait_members(base)
+
+    print("%d vlan members: added %.0f/s, removed %.0f/s" %
+          (members, members / max(add, 0.001), members / max(remove, 0.001)))
+
+    for vlan in vlans:
+        vlan_tbl._del("Vlan%d" % vlan)
+
+    time.sleep(2)